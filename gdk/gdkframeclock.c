@@ -90,12 +90,27 @@ static guint fps_counter;
 #define GDK_ARRAY_FREE_FUNC frame_timings_unref
 #include "gdk/gdkarrayimpl.c"
 
+typedef struct _FrameClockWork FrameClockWork;
+
+struct _FrameClockWork
+{
+  guint id;
+  GdkFrameClockWorkFunc func;
+  gpointer user_data;
+  GDestroyNotify notify;
+  guint removed : 1;
+};
+
 struct _GdkFrameClockPrivate
 {
   gint64 frame_counter;
   int current;
   Timings timings;
   int n_freeze_inhibitors;
+
+  GQueue work;
+  FrameClockWork *running_work;
+  guint work_id;
 };
 
 G_DEFINE_ABSTRACT_TYPE_WITH_PRIVATE (GdkFrameClock, gdk_frame_clock, G_TYPE_OBJECT)
@@ -103,11 +118,21 @@ G_DEFINE_ABSTRACT_TYPE_WITH_PRIVATE (GdkFrameClock, gdk_frame_clock, G_TYPE_OBJE
 static void
 _gdk_frame_clock_freeze (GdkFrameClock *clock);
 
+static void
+frame_clock_work_free (FrameClockWork *work)
+{
+  if (work->notify)
+    work->notify (work->user_data);
+
+  g_free (work);
+}
+
 static void
 gdk_frame_clock_finalize (GObject *object)
 {
   GdkFrameClockPrivate *priv = GDK_FRAME_CLOCK (object)->priv;
 
+  g_queue_clear_full (&priv->work, (GDestroyNotify) frame_clock_work_free);
   timings_clear (&priv->timings);
 
   G_OBJECT_CLASS (gdk_frame_clock_parent_class)->finalize (object);
@@ -595,12 +620,18 @@ _gdk_frame_clock_debug_print_timings (GdkFrameClock   *clock,
                               (timings->smoothed_frame_time - timings->frame_time) / 1000.,
                               (timings->smoothed_frame_time - previous_smoothed_frame_time) / 1000.);
     }
+  if (timings->update_start_time != 0)
+    g_string_append_printf (str, " update_start=%-4.1f", (timings->update_start_time - timings->frame_time) / 1000.);
   if (timings->layout_start_time != 0)
     g_string_append_printf (str, " layout_start=%-4.1f", (timings->layout_start_time - timings->frame_time) / 1000.);
   if (timings->paint_start_time != 0)
     g_string_append_printf (str, " paint_start=%-4.1f", (timings->paint_start_time - timings->frame_time) / 1000.);
   if (timings->frame_end_time != 0)
     g_string_append_printf (str, " frame_end=%-4.1f", (timings->frame_end_time - timings->frame_time) / 1000.);
+  if (timings->deadline != 0)
+    g_string_append_printf (str, " deadline=%-4.1f%s",
+                            (timings->deadline - timings->frame_time) / 1000.,
+                            timings->deadline_missed ? " (missed)" : "");
   if (timings->drawn_time != 0)
     g_string_append_printf (str, " drawn=%-4.1f", (timings->drawn_time - timings->frame_time) / 1000.);
   if (timings->presentation_time != 0)
@@ -837,6 +868,178 @@ gdk_frame_clock_get_fps (GdkFrameClock *frame_clock)
   return ((double) end_counter - start_counter) * G_USEC_PER_SEC / (end_timestamp - start_timestamp);
 }
 
+/**
+ * gdk_frame_clock_get_frame_deadline:
+ * @frame_clock: a `GdkFrameClock`
+ *
+ * Gets the time by which the frame currently being processed
+ * should be finished.
+ *
+ * Handlers of the phases of the frame clock can use this to
+ * decide how much work they can afford to do in this frame, and
+ * to defer the rest with [method@Gdk.FrameClock.add_work].
+ *
+ * Outside of a frame, this returns the deadline of the last frame.
+ *
+ * Returns: the deadline, in the timescale of g_get_monotonic_time(),
+ *   or 0 if no frame has been processed yet
+ *
+ * Since: 4.22
+ */
+gint64
+gdk_frame_clock_get_frame_deadline (GdkFrameClock *frame_clock)
+{
+  GdkFrameTimings *timings;
+
+  g_return_val_if_fail (GDK_IS_FRAME_CLOCK (frame_clock), 0);
+
+  timings = _gdk_frame_clock_get_timings (frame_clock, frame_clock->priv->frame_counter);
+  if (timings == NULL)
+    return 0;
+
+  return timings->deadline;
+}
+
+/**
+ * gdk_frame_clock_add_work:
+ * @frame_clock: a `GdkFrameClock`
+ * @func: (scope notified) (closure user_data) (destroy notify): function
+ *   to call
+ * @user_data: data to pass to @func
+ * @notify: function to call to free @user_data when the work is removed
+ *
+ * Adds work that is done in slices at the end of frames.
+ *
+ * After a frame has been painted, @func is called if there is time
+ * left before the deadline of the frame. It should do as much work
+ * as it can before the deadline it is passed and then return. As long
+ * as it returns %G_SOURCE_CONTINUE, it is called again at the end of
+ * the following frames, and the frame clock keeps producing frames
+ * for it.
+ *
+ * This is useful for work that is too expensive to do in a single
+ * frame, but can be interrupted, like laying out offscreen content.
+ *
+ * Returns: an id that can be passed to [method@Gdk.FrameClock.remove_work]
+ *
+ * Since: 4.22
+ */
+guint
+gdk_frame_clock_add_work (GdkFrameClock         *frame_clock,
+                          GdkFrameClockWorkFunc  func,
+                          gpointer               user_data,
+                          GDestroyNotify         notify)
+{
+  GdkFrameClockPrivate *priv;
+  FrameClockWork *work;
+
+  g_return_val_if_fail (GDK_IS_FRAME_CLOCK (frame_clock), 0);
+  g_return_val_if_fail (func != NULL, 0);
+
+  priv = frame_clock->priv;
+
+  work = g_new0 (FrameClockWork, 1);
+  work->id = ++priv->work_id;
+  work->func = func;
+  work->user_data = user_data;
+  work->notify = notify;
+
+  g_queue_push_tail (&priv->work, work);
+
+  gdk_frame_clock_request_phase (frame_clock, GDK_FRAME_CLOCK_PHASE_AFTER_PAINT);
+
+  return work->id;
+}
+
+/**
+ * gdk_frame_clock_remove_work:
+ * @frame_clock: a `GdkFrameClock`
+ * @id: an id returned by [method@Gdk.FrameClock.add_work]
+ *
+ * Removes work that was added with [method@Gdk.FrameClock.add_work].
+ *
+ * Since: 4.22
+ */
+void
+gdk_frame_clock_remove_work (GdkFrameClock *frame_clock,
+                             guint          id)
+{
+  GdkFrameClockPrivate *priv;
+  GList *l;
+
+  g_return_if_fail (GDK_IS_FRAME_CLOCK (frame_clock));
+  g_return_if_fail (id != 0);
+
+  priv = frame_clock->priv;
+
+  if (priv->running_work && priv->running_work->id == id)
+    {
+      priv->running_work->removed = TRUE;
+      return;
+    }
+
+  for (l = priv->work.head; l; l = l->next)
+    {
+      FrameClockWork *work = l->data;
+
+      if (work->id == id)
+        {
+          g_queue_delete_link (&priv->work, l);
+          frame_clock_work_free (work);
+          return;
+        }
+    }
+
+  g_warning ("No frame clock work with id %u", id);
+}
+
+/* Runs the queued work until @deadline, in round-robin order so
+ * that no work is starved. To guarantee progress, one item is run
+ * even if the deadline has already passed.
+ *
+ * Returns: TRUE if there is work left for the next frame
+ */
+gboolean
+_gdk_frame_clock_run_work (GdkFrameClock *frame_clock,
+                           gint64         deadline)
+{
+  GdkFrameClockPrivate *priv = frame_clock->priv;
+  guint i, n_work;
+  gint64 before G_GNUC_UNUSED;
+
+  if (g_queue_is_empty (&priv->work))
+    return FALSE;
+
+  before = GDK_PROFILER_CURRENT_TIME;
+
+  n_work = g_queue_get_length (&priv->work);
+  for (i = 0; i < n_work; i++)
+    {
+      FrameClockWork *work;
+      gboolean result;
+
+      if (i > 0 && g_get_monotonic_time () >= deadline)
+        break;
+
+      work = g_queue_pop_head (&priv->work);
+      if (work == NULL)
+        break;
+
+      priv->running_work = work;
+      result = work->func (frame_clock, deadline, work->user_data);
+      priv->running_work = NULL;
+
+      if (result == G_SOURCE_CONTINUE && !work->removed)
+        g_queue_push_tail (&priv->work, work);
+      else
+        frame_clock_work_free (work);
+    }
+
+  gdk_profiler_end_mark (before, "Frameclock work", NULL);
+
+  return !g_queue_is_empty (&priv->work);
+}
+
 void
 _gdk_frame_clock_add_timings_to_profiler (GdkFrameClock   *clock,
                                           GdkFrameTimings *timings)
@@ -851,5 +1054,12 @@ _gdk_frame_clock_add_timings_to_profiler (GdkFrameClock   *clock,
       gdk_profiler_add_mark (1000 * timings->presentation_time, 0, "Presented window", NULL);
     }
 
+  if (timings->deadline_missed)
+    {
+      gdk_profiler_add_mark (1000 * timings->deadline,
+                             1000 * (timings->frame_end_time - timings->deadline),
+                             "Missed frame deadline", NULL);
+    }
+
   gdk_profiler_set_counter (fps_counter, gdk_frame_clock_get_fps (clock));
 }
@@ -69,6 +69,26 @@ typedef enum {
   GDK_FRAME_CLOCK_PHASE_AFTER_PAINT   = 1 << 6
 } GdkFrameClockPhase;
 
+/**
+ * GdkFrameClockWorkFunc:
+ * @frame_clock: the frame clock
+ * @deadline: the time by which the work should be interrupted,
+ *   in the timescale of g_get_monotonic_time()
+ * @user_data: user data passed to [method@Gdk.FrameClock.add_work]
+ *
+ * Callback type for work done between frames.
+ *
+ * See [method@Gdk.FrameClock.add_work].
+ *
+ * Returns: %G_SOURCE_CONTINUE if there is more work to do,
+ *   %G_SOURCE_REMOVE if the work is done
+ *
+ * Since: 4.22
+ */
+typedef gboolean (* GdkFrameClockWorkFunc) (GdkFrameClock *frame_clock,
+                                            gint64         deadline,
+                                            gpointer       user_data);
+
 GDK_AVAILABLE_IN_ALL
 GType    gdk_frame_clock_get_type             (void) G_GNUC_CONST;
 
@@ -105,6 +125,18 @@ void gdk_frame_clock_get_refresh_info (GdkFrameClock *frame_clock,
 GDK_AVAILABLE_IN_ALL
 double gdk_frame_clock_get_fps (GdkFrameClock *frame_clock);
 
+GDK_AVAILABLE_IN_4_22
+gint64 gdk_frame_clock_get_frame_deadline (GdkFrameClock *frame_clock);
+
+GDK_AVAILABLE_IN_4_22
+guint  gdk_frame_clock_add_work    (GdkFrameClock         *frame_clock,
+                                    GdkFrameClockWorkFunc  func,
+                                    gpointer               user_data,
+                                    GDestroyNotify         notify);
+GDK_AVAILABLE_IN_4_22
+void   gdk_frame_clock_remove_work (GdkFrameClock         *frame_clock,
+                                    guint                  id);
+
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(GdkFrameClock, g_object_unref)
 
 G_END_DECLS
@@ -555,6 +555,8 @@ gdk_frame_clock_paint_idle (void *data)
               timings->frame_time = priv->frame_time;
               timings->smoothed_frame_time = priv->smoothed_frame_time_base;
               timings->slept_before = priv->sleep_serial != get_sleep_serial ();
+              /* The next cycle is scheduled one interval after the start of this one */
+              timings->deadline = priv->smoothed_frame_time_base - priv->smoothed_frame_time_phase + frame_interval;
 
               priv->phase = GDK_FRAME_CLOCK_PHASE_BEFORE_PAINT;
 
@@ -575,6 +577,9 @@ gdk_frame_clock_paint_idle (void *data)
               if ((priv->requested & GDK_FRAME_CLOCK_PHASE_UPDATE) != 0 ||
                   priv->updating_count > 0)
                 {
+                  if (timings && timings->update_start_time == 0)
+                    timings->update_start_time = g_get_monotonic_time ();
+
                   priv->requested &= ~GDK_FRAME_CLOCK_PHASE_UPDATE;
                   _gdk_frame_clock_emit_update (clock);
                 }
@@ -585,15 +590,10 @@ gdk_frame_clock_paint_idle (void *data)
           if (!gdk_frame_clock_idle_is_frozen (clock_idle))
             {
 	      int iter;
-              if (GDK_DEBUG_CHECK (FRAMES))
-                {
-                  if (priv->phase != GDK_FRAME_CLOCK_PHASE_LAYOUT &&
-                      (priv->requested & GDK_FRAME_CLOCK_PHASE_LAYOUT))
-                    {
-                      if (timings)
-                        timings->layout_start_time = g_get_monotonic_time ();
-                    }
-                }
+              if (timings &&
+                  priv->phase != GDK_FRAME_CLOCK_PHASE_LAYOUT &&
+                  (priv->requested & GDK_FRAME_CLOCK_PHASE_LAYOUT))
+                timings->layout_start_time = g_get_monotonic_time ();
 
               priv->phase = GDK_FRAME_CLOCK_PHASE_LAYOUT;
 	      /* We loop in the layout phase, because we don't want to progress
@@ -617,15 +617,10 @@ gdk_frame_clock_paint_idle (void *data)
         case GDK_FRAME_CLOCK_PHASE_PAINT:
           if (!gdk_frame_clock_idle_is_frozen (clock_idle))
             {
-              if (GDK_DEBUG_CHECK (FRAMES))
-                {
-                  if (priv->phase != GDK_FRAME_CLOCK_PHASE_PAINT &&
-                      (priv->requested & GDK_FRAME_CLOCK_PHASE_PAINT))
-                    {
-                      if (timings)
-                        timings->paint_start_time = g_get_monotonic_time ();
-                    }
-                }
+              if (timings &&
+                  priv->phase != GDK_FRAME_CLOCK_PHASE_PAINT &&
+                  (priv->requested & GDK_FRAME_CLOCK_PHASE_PAINT))
+                timings->paint_start_time = g_get_monotonic_time ();
 
               priv->phase = GDK_FRAME_CLOCK_PHASE_PAINT;
               if (priv->requested & GDK_FRAME_CLOCK_PHASE_PAINT)
@@ -645,10 +640,20 @@ gdk_frame_clock_paint_idle (void *data)
                */
               priv->phase = GDK_FRAME_CLOCK_PHASE_NONE;
             }
-          if (GDK_DEBUG_CHECK (FRAMES))
+          if (timings)
             {
-              if (timings)
-                timings->frame_end_time = g_get_monotonic_time ();
+              timings->frame_end_time = g_get_monotonic_time ();
+              timings->deadline_missed = timings->deadline != 0 &&
+                                         timings->frame_end_time > timings->deadline;
+
+              /* Use what is left of the frame for deferred work. Backends
+               * freeze the clock in ::after-paint until the frame has been
+               * presented, which is exactly the gap the work should fill,
+               * so it runs even when frozen. Pending work then continues
+               * once the clock is thawed again.
+               */
+              if (_gdk_frame_clock_run_work (clock, timings->deadline))
+                priv->requested |= GDK_FRAME_CLOCK_PHASE_AFTER_PAINT;
             }
           G_GNUC_FALLTHROUGH;
 
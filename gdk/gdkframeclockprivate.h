@@ -95,12 +95,15 @@ struct _GdkFrameTimings
   gint64 refresh_interval;
   gint64 predicted_presentation_time;
 
+  gint64 deadline;
+  gint64 update_start_time;
   gint64 layout_start_time;
   gint64 paint_start_time;
   gint64 frame_end_time;
 
   guint complete : 1;
   guint slept_before : 1;
+  guint deadline_missed : 1;
 };
 
 void _gdk_frame_clock_inhibit_freeze (GdkFrameClock *clock);
@@ -126,5 +129,8 @@ void _gdk_frame_clock_emit_paint         (GdkFrameClock *frame_clock);
 void _gdk_frame_clock_emit_after_paint   (GdkFrameClock *frame_clock);
 void _gdk_frame_clock_emit_resume_events (GdkFrameClock *frame_clock);
 
+gboolean _gdk_frame_clock_run_work       (GdkFrameClock *frame_clock,
+                                          gint64         deadline);
+
 G_END_DECLS
 
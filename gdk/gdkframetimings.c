@@ -235,3 +235,47 @@ gdk_frame_timings_get_refresh_interval (GdkFrameTimings *timings)
 
   return timings->refresh_interval;
 }
+
+/**
+ * gdk_frame_timings_get_deadline:
+ * @timings: a `GdkFrameTimings`
+ *
+ * Gets the time by which the frame clock wanted to be done
+ * with this frame.
+ *
+ * This is the time at which the next frame is expected to start.
+ *
+ * Returns: the deadline of the frame, in the timescale of
+ *   g_get_monotonic_time(), or 0 if the frame was never started
+ *
+ * Since: 4.22
+ */
+gint64
+gdk_frame_timings_get_deadline (GdkFrameTimings *timings)
+{
+  g_return_val_if_fail (timings != NULL, 0);
+
+  return timings->deadline;
+}
+
+/**
+ * gdk_frame_timings_get_deadline_missed:
+ * @timings: a `GdkFrameTimings`
+ *
+ * Returns whether updating, laying out and painting the frame
+ * took longer than the deadline allowed.
+ *
+ * Frames that missed their deadline usually cause the next
+ * frame to be skipped.
+ *
+ * Returns: true if the frame was finished after its deadline
+ *
+ * Since: 4.22
+ */
+gboolean
+gdk_frame_timings_get_deadline_missed (GdkFrameTimings *timings)
+{
+  g_return_val_if_fail (timings != NULL, FALSE);
+
+  return timings->deadline_missed;
+}
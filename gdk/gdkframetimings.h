@@ -49,6 +49,11 @@ gint64           gdk_frame_timings_get_refresh_interval  (GdkFrameTimings *timin
 GDK_AVAILABLE_IN_ALL
 gint64           gdk_frame_timings_get_predicted_presentation_time (GdkFrameTimings *timings);
 
+GDK_AVAILABLE_IN_4_22
+gint64           gdk_frame_timings_get_deadline        (GdkFrameTimings *timings);
+GDK_AVAILABLE_IN_4_22
+gboolean         gdk_frame_timings_get_deadline_missed (GdkFrameTimings *timings);
+
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(GdkFrameTimings, gdk_frame_timings_unref)
 
 G_END_DECLS
@@ -20,6 +20,7 @@
 #include "gdk/gdkdmabufdownloaderprivate.h"
 #include "gdk/gdkdmabuftextureprivate.h"
 #include "gdk/gdkdrawcontextprivate.h"
+#include "gdk/gdkprofilerprivate.h"
 #include "gdk/gdktexturedownloaderprivate.h"
 
 #define DEFAULT_VERTEX_BUFFER_SIZE 128 * 1024
@@ -57,10 +58,14 @@ struct _GskGpuFramePrivate
   GskGpuBuffer *storage_buffer;
   guchar *storage_buffer_data;
   gsize storage_buffer_used;
+
+  gsize n_occluded_nodes;
 };
 
 G_DEFINE_TYPE_WITH_PRIVATE (GskGpuFrame, gsk_gpu_frame, G_TYPE_OBJECT)
 
+static guint occluded_nodes_counter;
+
 static void
 gsk_gpu_frame_default_setup (GskGpuFrame *self)
 {
@@ -284,6 +289,24 @@ gsk_gpu_frame_get_timestamp (GskGpuFrame *self)
   return priv->timestamp;
 }
 
+/*
+ * gsk_gpu_frame_add_occluded_nodes:
+ * @self: a frame
+ * @n_nodes: the number of nodes
+ *
+ * Records that @n_nodes were not drawn because they were covered by
+ * an opaque node drawn later. The total per frame is reported to the
+ * profiler.
+ */
+void
+gsk_gpu_frame_add_occluded_nodes (GskGpuFrame *self,
+                                  gsize        n_nodes)
+{
+  GskGpuFramePrivate *priv = gsk_gpu_frame_get_instance_private (self);
+
+  priv->n_occluded_nodes += n_nodes;
+}
+
 gboolean
 gsk_gpu_frame_should_optimize (GskGpuFrame         *self,
                                GskGpuOptimizations  optimization)
@@ -753,11 +776,20 @@ gsk_gpu_frame_record (GskGpuFrame            *self,
 
   priv->timestamp = timestamp;
   gsk_gpu_cache_set_time (gsk_gpu_device_get_cache (priv->device), timestamp);
+  priv->n_occluded_nodes = 0;
 
   gsk_gpu_node_processor_process (self, target, target_color_state, clip, node, viewport, pass_type);
 
   if (texture)
     gsk_gpu_download_op (self, target, target_color_state, texture);
+
+  if (GDK_PROFILER_IS_RUNNING)
+    {
+      if (occluded_nodes_counter == 0)
+        occluded_nodes_counter = gdk_profiler_define_int_counter ("occluded-nodes",
+                                                                  "Render nodes skipped because they were covered");
+      gdk_profiler_set_int_counter (occluded_nodes_counter, priv->n_occluded_nodes);
+    }
 }
 
 static void
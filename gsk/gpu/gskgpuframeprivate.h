@@ -82,6 +82,8 @@ GskGpuDevice *          gsk_gpu_frame_get_device                        (GskGpuF
 gint64                  gsk_gpu_frame_get_timestamp                     (GskGpuFrame            *self) G_GNUC_PURE;
 gboolean                gsk_gpu_frame_should_optimize                   (GskGpuFrame            *self,
                                                                          GskGpuOptimizations     optimization) G_GNUC_PURE;
+void                    gsk_gpu_frame_add_occluded_nodes                (GskGpuFrame            *self,
+                                                                         gsize                   n_nodes);
 
 gpointer                gsk_gpu_frame_alloc_op                          (GskGpuFrame            *self,
                                                                          gsize                   size);
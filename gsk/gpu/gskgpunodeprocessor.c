@@ -3796,20 +3796,26 @@ gsk_gpu_node_processor_add_container_node (GskGpuNodeProcessor *self,
 
   children = gsk_container_node_get_children (node, &n_children);
 
-  if (node->fully_opaque && !gsk_container_node_is_disjoint (node) && n_children > 0)
+  i = 0;
+  if (!gsk_container_node_is_disjoint (node) && n_children > 1)
     {
-      graphene_rect_t opaque;
+      graphene_rect_t visible, opaque;
 
-      /* Try to find a child that fully covers the container node */
-      for (i = n_children - 1; i > 0; i--)
+      /* Try to find a child that covers the visible part of the container
+       * node, everything below it doesn't need to be drawn. If no child has
+       * an opaque region, the container has none either. */
+      if (gsk_render_node_get_opaque_rect (node, &opaque) &&
+          gsk_gpu_node_processor_clip_node_bounds (self, node, &visible))
         {
-          if (gsk_render_node_get_opaque_rect (children[i], &opaque) &&
-              gsk_rect_equal (&opaque, &node->bounds))
-            break;
+          for (i = n_children - 1; i > 0; i--)
+            {
+              if (gsk_render_node_get_opaque_rect (children[i], &opaque) &&
+                  gsk_rect_contains_rect (&opaque, &visible))
+                break;
+            }
+          gsk_gpu_frame_add_occluded_nodes (self->frame, i);
         }
     }
-  else
-    i = 0;
 
   for (; i < n_children; i++)
     gsk_gpu_node_processor_add_node (self, children[i]);
@@ -3841,6 +3847,8 @@ gsk_gpu_node_processor_add_first_container_node (GskGpuNodeProcessor *self,
 
   if (i < 0)
     gsk_gpu_first_node_begin_rendering (self, info, GSK_VEC4_TRANSPARENT);
+  else
+    gsk_gpu_frame_add_occluded_nodes (self->frame, i);
 
   for (i++; i < n; i++)
     gsk_gpu_node_processor_add_node (self, children[i]);
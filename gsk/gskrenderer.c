@@ -70,9 +70,17 @@ typedef struct
 
   GskDebugFlags debug_flags;
 
+  /* Time in µs that diffing against prev_node may take, or 0 */
+  gint64 diff_budget;
+
   unsigned int is_realized : 1;
 } GskRendererPrivate;
 
+/* Diffing is supposed to be much cheaper than redrawing. If it takes
+ * longer than this, we give up and redraw the remaining nodes.
+ */
+#define DEFAULT_DIFF_BUDGET 4000
+
 G_DEFINE_ABSTRACT_TYPE_WITH_PRIVATE (GskRenderer, gsk_renderer, G_TYPE_OBJECT)
 
 enum {
@@ -203,8 +211,28 @@ gsk_renderer_init (GskRenderer *self)
 {
   GskRendererPrivate *priv = gsk_renderer_get_instance_private (self);
 
+  const char *str;
+
   priv->profiler = gsk_profiler_new ();
   priv->debug_flags = gsk_get_debug_flags ();
+  priv->diff_budget = DEFAULT_DIFF_BUDGET;
+
+  str = g_getenv ("GSK_DIFF_BUDGET");
+  if (str != NULL)
+    {
+      gint64 value;
+      GError *error = NULL;
+
+      if (!g_ascii_string_to_signed (str, 10, 0, G_MAXINT, &value, &error))
+        {
+          g_warning ("Failed to parse GSK_DIFF_BUDGET: %s", error->message);
+          g_error_free (error);
+        }
+      else
+        {
+          priv->diff_budget = value;
+        }
+    }
 }
 
 /**
@@ -479,7 +507,20 @@ gsk_renderer_render (GskRenderer          *renderer,
     }
   else
     {
-      gsk_render_node_diff (priv->prev_node, root, &(GskDiffData) { clip, priv->surface });
+      GskDiffBudget budget = { 0, };
+      gint64 before_diff = g_get_monotonic_time ();
+
+      if (priv->diff_budget > 0)
+        budget.deadline = before_diff + priv->diff_budget;
+
+      gsk_render_node_diff (priv->prev_node, root, &(GskDiffData) { clip, priv->surface, &budget });
+
+      GSK_RENDERER_DEBUG (renderer, RENDERER,
+                          "Diffed %u nodes in %.3f ms%s, %d rectangles changed",
+                          budget.n_nodes,
+                          (g_get_monotonic_time () - before_diff) / 1000.,
+                          budget.exceeded ? " (budget exceeded)" : "",
+                          cairo_region_num_rectangles (clip));
     }
 
   renderer_class->render (renderer, root, clip);
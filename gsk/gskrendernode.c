@@ -557,6 +557,26 @@ gsk_render_node_diff_impossible (GskRenderNode  *node1,
   cairo_region_union_rectangle (data->region, &rect);
 }
 
+/* Checking the clock for every node would be too expensive */
+#define DIFF_BUDGET_CHECK_INTERVAL 64
+
+static gboolean
+gsk_diff_budget_exceeded (GskDiffBudget *budget)
+{
+  budget->n_nodes++;
+
+  if (budget->exceeded || budget->deadline == 0)
+    return budget->exceeded;
+
+  if (budget->countdown-- == 0)
+    {
+      budget->countdown = DIFF_BUDGET_CHECK_INTERVAL;
+      budget->exceeded = g_get_monotonic_time () > budget->deadline;
+    }
+
+  return budget->exceeded;
+}
+
 /**
  * gsk_render_node_diff:
  * @node1: a render node
@@ -574,6 +594,9 @@ gsk_render_node_diff_impossible (GskRenderNode  *node1,
  *
  * Note that the passed in @region may already contain previous results from
  * previous node comparisons, so this function call will only add to it.
+ *
+ * If @data has a budget, nodes that are reached after its deadline are
+ * not compared anymore, their bounds are added to the region instead.
  */
 void
 gsk_render_node_diff (GskRenderNode  *node1,
@@ -583,6 +606,12 @@ gsk_render_node_diff (GskRenderNode  *node1,
   if (node1 == node2)
     return;
 
+  if (data->budget && gsk_diff_budget_exceeded (data->budget))
+    {
+      gsk_render_node_diff_impossible (node1, node2, data);
+      return;
+    }
+
   if (gsk_render_node_get_node_type (node1) == gsk_render_node_get_node_type (node2))
     {
       GSK_RENDER_NODE_GET_CLASS (node1)->diff (node1, node2, data);
@@ -4353,6 +4353,10 @@ gsk_container_node_keep_func (gconstpointer elem1, gconstpointer elem2, gpointer
   if (cairo_region_num_rectangles (data->region) > MAX_RECTS_IN_DIFF)
     return GSK_DIFF_ABORTED;
 
+  /* Stop the search too, the container falls back to its bounds */
+  if (data->budget && data->budget->exceeded)
+    return GSK_DIFF_ABORTED;
+
   return GSK_DIFF_OK;
 }
 
@@ -4368,6 +4372,9 @@ gsk_container_node_change_func (gconstpointer elem, gsize idx, gpointer user_dat
   if (cairo_region_num_rectangles (data->region) > MAX_RECTS_IN_DIFF)
     return GSK_DIFF_ABORTED;
 
+  if (data->budget && data->budget->exceeded)
+    return GSK_DIFF_ABORTED;
+
   return GSK_DIFF_OK;
 }
 
@@ -4708,7 +4715,7 @@ gsk_transform_node_diff (GskRenderNode *node1,
         float dx, dy;
         gsk_transform_to_translate (self1->transform, &dx, &dy);
         sub = cairo_region_create ();
-        gsk_render_node_diff (self1->child, self2->child, &(GskDiffData) { sub, data->surface });
+        gsk_render_node_diff (self1->child, self2->child, &(GskDiffData) { sub, data->surface, data->budget });
         cairo_region_translate (sub, floorf (dx), floorf (dy));
         if (floorf (dx) != dx)
           {
@@ -4735,7 +4742,7 @@ gsk_transform_node_diff (GskRenderNode *node1,
         float scale_x, scale_y, dx, dy;
         gsk_transform_to_affine (self1->transform, &scale_x, &scale_y, &dx, &dy);
         sub = cairo_region_create ();
-        gsk_render_node_diff (self1->child, self2->child, &(GskDiffData) { sub, data->surface });
+        gsk_render_node_diff (self1->child, self2->child, &(GskDiffData) { sub, data->surface, data->budget });
         region_union_region_affine (data->region, sub, scale_x, scale_y, dx, dy);
         cairo_region_destroy (sub);
       }
@@ -5453,7 +5460,7 @@ gsk_repeat_node_diff (GskRenderNode *node1,
       cairo_region_t *sub;
 
       sub = cairo_region_create();
-      gsk_render_node_diff (self1->child, self2->child, &(GskDiffData) { sub, data->surface });
+      gsk_render_node_diff (self1->child, self2->child, &(GskDiffData) { sub, data->surface, data->budget });
       if (cairo_region_is_empty (sub))
         {
           cairo_region_destroy (sub);
@@ -5619,7 +5626,7 @@ gsk_clip_node_diff (GskRenderNode *node1,
       cairo_rectangle_int_t clip_rect;
 
       sub = cairo_region_create();
-      gsk_render_node_diff (self1->child, self2->child, &(GskDiffData) { sub, data->surface });
+      gsk_render_node_diff (self1->child, self2->child, &(GskDiffData) { sub, data->surface, data->budget });
       gsk_rect_to_cairo_grow (&self1->clip, &clip_rect);
       cairo_region_intersect_rectangle (sub, &clip_rect);
       cairo_region_union (data->region, sub);
@@ -5786,7 +5793,7 @@ gsk_rounded_clip_node_diff (GskRenderNode *node1,
       cairo_rectangle_int_t clip_rect;
 
       sub = cairo_region_create();
-      gsk_render_node_diff (self1->child, self2->child, &(GskDiffData) { sub, data->surface });
+      gsk_render_node_diff (self1->child, self2->child, &(GskDiffData) { sub, data->surface, data->budget });
       gsk_rect_to_cairo_grow (&self1->clip.bounds, &clip_rect);
       cairo_region_intersect_rectangle (sub, &clip_rect);
       cairo_region_union (data->region, sub);
@@ -5992,7 +5999,7 @@ gsk_fill_node_diff (GskRenderNode *node1,
       cairo_rectangle_int_t clip_rect;
 
       sub = cairo_region_create();
-      gsk_render_node_diff (self1->child, self2->child, &(GskDiffData) { sub, data->surface });
+      gsk_render_node_diff (self1->child, self2->child, &(GskDiffData) { sub, data->surface, data->budget });
       gsk_rect_to_cairo_grow (&node1->bounds, &clip_rect);
       cairo_region_intersect_rectangle (sub, &clip_rect);
       cairo_region_union (data->region, sub);
@@ -6200,7 +6207,7 @@ gsk_stroke_node_diff (GskRenderNode *node1,
       cairo_rectangle_int_t clip_rect;
 
       sub = cairo_region_create();
-      gsk_render_node_diff (self1->child, self2->child, &(GskDiffData) { sub, data->surface });
+      gsk_render_node_diff (self1->child, self2->child, &(GskDiffData) { sub, data->surface, data->budget });
       gsk_rect_to_cairo_grow (&node1->bounds, &clip_rect);
       cairo_region_intersect_rectangle (sub, &clip_rect);
       cairo_region_union (data->region, sub);
@@ -6453,7 +6460,7 @@ gsk_shadow_node_diff (GskRenderNode *node1,
     }
 
   sub = cairo_region_create ();
-  gsk_render_node_diff (self1->child, self2->child, &(GskDiffData) { sub, data->surface });
+  gsk_render_node_diff (self1->child, self2->child, &(GskDiffData) { sub, data->surface, data->budget });
 
   n = cairo_region_num_rectangles (sub);
   for (i = 0; i < n; i++)
@@ -7689,7 +7696,7 @@ gsk_blur_node_diff (GskRenderNode *node1,
 
       clip_radius = ceil (gsk_cairo_blur_compute_pixels (self1->radius / 2.0));
       sub = cairo_region_create ();
-      gsk_render_node_diff (self1->child, self2->child, &(GskDiffData) { sub, data->surface });
+      gsk_render_node_diff (self1->child, self2->child, &(GskDiffData) { sub, data->surface, data->budget });
 
       n = cairo_region_num_rectangles (sub);
       for (i = 0; i < n; i++)
@@ -8269,7 +8276,7 @@ gsk_gl_shader_node_diff (GskRenderNode *node1,
     {
       cairo_region_t *child_region = cairo_region_create();
       for (guint i = 0; i < self1->n_children; i++)
-        gsk_render_node_diff (self1->children[i], self2->children[i], &(GskDiffData) { child_region, data->surface });
+        gsk_render_node_diff (self1->children[i], self2->children[i], &(GskDiffData) { child_region, data->surface, data->budget });
       if (!cairo_region_is_empty (child_region))
         gsk_render_node_diff_impossible (node1, node2, data);
       cairo_region_destroy (child_region);
@@ -39,10 +39,22 @@ struct _GskRenderNode
   guint is_hdr : 1;
 };
 
+/* Limits the time spent in gsk_render_node_diff(). Once the deadline
+ * has passed, the remaining nodes are treated as fully changed.
+ */
+typedef struct
+{
+  gint64 deadline;
+  guint n_nodes;
+  guint countdown;
+  guint exceeded : 1;
+} GskDiffBudget;
+
 typedef struct
 {
   cairo_region_t *region;
   GdkSurface *surface;
+  GskDiffBudget *budget;
 } GskDiffData;
 
 struct _GskRenderNodeClass
@@ -58,6 +58,21 @@ gsk_pango_renderer_set_shape_handler (GskPangoRenderer    *crenderer,
   crenderer->shape_handler = handler;
 }
 
+void
+gsk_pango_renderer_set_cull_rect (GskPangoRenderer      *crenderer,
+                                  const graphene_rect_t *rect)
+{
+  g_return_if_fail (GSK_IS_PANGO_RENDERER (crenderer));
+
+  if (rect)
+    {
+      crenderer->cull_rect = *rect;
+      crenderer->has_cull_rect = TRUE;
+    }
+  else
+    crenderer->has_cull_rect = FALSE;
+}
+
 static void
 get_color (GskPangoRenderer *crenderer,
            PangoRenderPart   part,
@@ -107,6 +122,70 @@ get_item_bounds (PangoGlyphItem  *run,
   graphene_rect_init (bounds, ink_rect.x, ink_rect.y, ink_rect.width, ink_rect.height);
 }
 
+/* Runs shorter than this are always drawn in full */
+#define CULL_MIN_GLYPHS 256
+
+/* Restricts @glyphs to the glyphs that are close to the cull rect
+ * and moves @x to the position of the first of them. Returns %FALSE
+ * if none of the glyphs are visible.
+ */
+static gboolean
+cull_glyph_string (GskPangoRenderer *crenderer,
+                   PangoFont        *font,
+                   PangoGlyphString *glyphs,
+                   int              *x,
+                   int               y,
+                   PangoGlyphString *culled)
+{
+  PangoFontDescription *desc;
+  int margin, left, right;
+  int first = -1, last = -1;
+  int first_x = 0;
+  int pos;
+
+  /* Leave room for ink that extends past the logical extents */
+  desc = pango_font_describe_with_absolute_size (font);
+  margin = 2 * pango_font_description_get_size (desc);
+  pango_font_description_free (desc);
+
+  if (y + margin < crenderer->cull_rect.origin.y * PANGO_SCALE ||
+      y - margin > (crenderer->cull_rect.origin.y + crenderer->cull_rect.size.height) * PANGO_SCALE)
+    return FALSE;
+
+  left = crenderer->cull_rect.origin.x * PANGO_SCALE - margin;
+  right = (crenderer->cull_rect.origin.x + crenderer->cull_rect.size.width) * PANGO_SCALE + margin;
+
+  pos = *x;
+  for (int i = 0; i < glyphs->num_glyphs && pos <= right; i++)
+    {
+      int width = glyphs->glyphs[i].geometry.width;
+
+      if (pos + width >= left)
+        {
+          if (first < 0)
+            {
+              first = i;
+              first_x = pos;
+            }
+          last = i;
+        }
+
+      pos += width;
+    }
+
+  if (first < 0)
+    return FALSE;
+
+  culled->num_glyphs = last - first + 1;
+  culled->glyphs = glyphs->glyphs + first;
+  culled->log_clusters = glyphs->log_clusters + first;
+  culled->space = culled->num_glyphs;
+
+  *x = first_x;
+
+  return TRUE;
+}
+
 static void
 gsk_pango_renderer_draw_glyph_item (PangoRenderer  *renderer,
                                     const char     *text,
@@ -119,10 +198,28 @@ gsk_pango_renderer_draw_glyph_item (PangoRenderer  *renderer,
   GtkCssValue *text_shadow;
   gboolean has_color_glyphs;
   gboolean has_alpha;
+  PangoGlyphString culled_glyphs;
+  PangoGlyphItem culled_item;
 
   if (!glyph_item->item->analysis.font)
     return;
 
+  if (crenderer->has_cull_rect &&
+      glyph_item->glyphs->num_glyphs > CULL_MIN_GLYPHS &&
+      pango_renderer_get_matrix (renderer) == NULL)
+    {
+      if (!cull_glyph_string (crenderer,
+                              glyph_item->item->analysis.font,
+                              glyph_item->glyphs,
+                              &x, y,
+                              &culled_glyphs))
+        return;
+
+      culled_item = *glyph_item;
+      culled_item.glyphs = &culled_glyphs;
+      glyph_item = &culled_item;
+    }
+
   has_color_glyphs = gtk_pango_glyph_item_has_color_glyphs (glyph_item);
 
   if (crenderer->shadow_style)
@@ -556,6 +653,8 @@ gsk_pango_renderer_release (GskPangoRenderer *renderer)
       renderer->snapshot = NULL;
       renderer->shadow_style = NULL;
 
+      renderer->has_cull_rect = FALSE;
+
       if (renderer->error_color)
         {
           gdk_rgba_free (renderer->error_color);
@@ -67,6 +67,10 @@ struct _GskPangoRenderer
   GskPangoRendererState  state;
 
   guint                  is_cached_renderer : 1;
+  guint                  has_cull_rect : 1;
+
+  /* Glyphs far outside of this area are not drawn */
+  graphene_rect_t        cull_rect;
 
   GskPangoShapeHandler   shape_handler;
 };
@@ -81,6 +85,8 @@ void              gsk_pango_renderer_set_state (GskPangoRenderer      *crenderer
                                                 GskPangoRendererState  state);
 void              gsk_pango_renderer_set_shape_handler (GskPangoRenderer      *crenderer,
                                                         GskPangoShapeHandler handler);
+void              gsk_pango_renderer_set_cull_rect (GskPangoRenderer      *crenderer,
+                                                    const graphene_rect_t *rect);
 GskPangoRenderer *gsk_pango_renderer_acquire   (void);
 void              gsk_pango_renderer_release   (GskPangoRenderer      *crenderer);
 
@@ -259,6 +259,91 @@ gtk_bitset_get_nth (const GtkBitset *self,
   return result;
 }
 
+/**
+ * gtk_bitset_get_next_range:
+ * @self: a `GtkBitset`
+ * @start: the value to start searching at
+ * @first: (out) (optional): set to the first value of the range
+ * @last: (out) (optional): set to the last value of the range
+ *
+ * Finds the first range of consecutive values in @self that contains
+ * a value >= @start.
+ *
+ * The range is maximal towards the end, so @last + 1 is not part of
+ * @self. If @start is part of a range, @first is set to @start.
+ *
+ * This allows walking a set one run at a time instead of one value
+ * at a time:
+ *
+ * ```c
+ * guint first, last;
+ *
+ * for (gboolean more = gtk_bitset_get_next_range (set, 0, &first, &last);
+ *      more;
+ *      more = last < G_MAXUINT && gtk_bitset_get_next_range (set, last + 1, &first, &last))
+ *   {
+ *     do_something_with_range (first, last);
+ *   }
+ * ```
+ *
+ * If no value >= @start exists in @self, %FALSE is returned and
+ * @first and @last are set to 0.
+ *
+ * Returns: %TRUE if a range was found
+ *
+ * Since: 4.22
+ */
+gboolean
+gtk_bitset_get_next_range (const GtkBitset *self,
+                           guint            start,
+                           guint           *first,
+                           guint           *last)
+{
+  roaring_uint32_iterator_t riter;
+  guint64 step;
+  guint hi;
+
+  g_return_val_if_fail (self != NULL, FALSE);
+
+  roaring_iterator_init (&self->roaring, &riter);
+  if (!roaring_uint32_iterator_move_equalorlarger (&riter, start))
+    {
+      if (first)
+        *first = 0;
+      if (last)
+        *last = 0;
+      return FALSE;
+    }
+
+  /* Gallop towards the end of the run. Containment checks are cheap
+   * for run and bitmap containers, so this avoids touching every value.
+   * [riter.current_value, hi] is always part of the set.
+   */
+  hi = riter.current_value;
+  step = 1;
+  while (hi < G_MAXUINT)
+    {
+      guint next = hi + MIN (step, G_MAXUINT - hi);
+
+      if (roaring_bitmap_contains_range_closed (&self->roaring, hi + 1, next))
+        {
+          hi = next;
+          step *= 2;
+        }
+      else if (step > 1)
+        step /= 2;
+      else
+        break;
+    }
+
+  if (first)
+    *first = riter.current_value;
+  if (last)
+    *last = hi;
+
+  return TRUE;
+}
+
 /**
  * gtk_bitset_new_empty:
  *
@@ -56,6 +56,11 @@ guint64                 gtk_bitset_get_size_in_range            (const GtkBitset
 GDK_AVAILABLE_IN_ALL
 guint                   gtk_bitset_get_nth                      (const GtkBitset        *self,
                                                                  guint                   nth);
+GDK_AVAILABLE_IN_4_22
+gboolean                gtk_bitset_get_next_range               (const GtkBitset        *self,
+                                                                 guint                   start,
+                                                                 guint                  *first,
+                                                                 guint                  *last);
 GDK_AVAILABLE_IN_ALL
 guint                   gtk_bitset_get_minimum                  (const GtkBitset        *self);
 GDK_AVAILABLE_IN_ALL
@@ -191,6 +191,46 @@ count_expand_children (GtkWidget *widget,
     }
 }
 
+static void
+prefetch_children (GtkWidget      *widget,
+                   GtkOrientation  orientation,
+                   int             for_size)
+{
+  GtkWidget **children;
+  int *for_sizes;
+  GtkWidget *child;
+  int n = 0;
+
+  if (!gtk_widget_can_prefetch_measure ())
+    return;
+
+  for (child = _gtk_widget_get_first_child (widget);
+       child != NULL;
+       child = _gtk_widget_get_next_sibling (child))
+    n++;
+
+  if (n < 2)
+    return;
+
+  children = g_newa (GtkWidget *, n);
+  for_sizes = g_newa (int, n);
+  n = 0;
+
+  for (child = _gtk_widget_get_first_child (widget);
+       child != NULL;
+       child = _gtk_widget_get_next_sibling (child))
+    {
+      if (!gtk_widget_should_layout (child))
+        continue;
+
+      children[n] = child;
+      for_sizes[n] = for_size;
+      n++;
+    }
+
+  gtk_widget_prefetch_measure (children, for_sizes, n, orientation);
+}
+
 static int
 get_spacing (GtkBoxLayout *self,
              GtkCssNode   *node)
@@ -227,6 +267,8 @@ gtk_box_layout_compute_size (GtkBoxLayout *self,
   gboolean have_baseline = FALSE;
   int pos;
 
+  prefetch_children (widget, self->orientation, for_size);
+
   for (child = gtk_widget_get_first_child (widget), pos = 0;
        child != NULL;
        child = gtk_widget_get_next_sibling (child), pos++)
@@ -969,6 +1011,10 @@ gtk_box_layout_allocate (GtkLayoutManager *layout_manager,
     }
 
   /* Now, measure inconstant-size children. */
+  if (n_inconstant > 1)
+    prefetch_children (widget, self->orientation,
+                       self->orientation == GTK_ORIENTATION_HORIZONTAL ? height : width);
+
   for (i = 0, child = _gtk_widget_get_first_child (widget);
        n_inconstant != 0 && child != NULL;
        child = _gtk_widget_get_next_sibling (child))
@@ -70,6 +70,11 @@
  * disabled with the [property@Gtk.ColumnView:reorderable] and
  * [property@Gtk.ColumnViewColumn:resizable] properties.
  *
+ * Cells of columns that are scrolled far out of view are neither
+ * allocated nor drawn, but they are still created and measured.
+ * For very wide tables, setting [property@Gtk.ColumnViewColumn:fixed-width]
+ * on the columns avoids measuring all their cells to determine the width.
+ *
  * To learn more about the list widget framework, see the
  * [overview](section-list-widget.html).
  *
@@ -129,6 +134,11 @@ struct _GtkColumnView
 
   GtkAdjustment *hadjustment;
 
+  /* horizontal range that cells are laid out for,
+   * everything if start > end */
+  int cell_range_start;
+  int cell_range_end;
+
   guint reorderable : 1;
   guint show_column_separators : 1;
   guint in_column_resize : 1;
@@ -481,6 +491,25 @@ gtk_column_view_allocate_columns (GtkColumnView *self,
   return total_width;
 }
 
+/* Returns TRUE if the range changed */
+static gboolean
+gtk_column_view_update_cell_range (GtkColumnView *self,
+                                   int            view_start,
+                                   int            view_width)
+{
+  if (self->cell_range_start <= self->cell_range_end &&
+      view_start >= self->cell_range_start &&
+      view_start + view_width <= self->cell_range_end)
+    return FALSE;
+
+  /* Add half a page on either side, so scrolling doesn't need
+   * to relayout the rows all the time */
+  self->cell_range_start = view_start - view_width / 2;
+  self->cell_range_end = view_start + view_width + view_width / 2;
+
+  return TRUE;
+}
+
 static void
 gtk_column_view_allocate (GtkWidget *widget,
                           int        width,
@@ -489,6 +518,8 @@ gtk_column_view_allocate (GtkWidget *widget,
 {
   GtkColumnView *self = GTK_COLUMN_VIEW (widget);
   int full_width, header_height, min, nat, x, dx;
+  gboolean cell_range_changed;
+  GtkWidget *child;
 
   x = gtk_adjustment_get_value (self->hadjustment);
   full_width = gtk_column_view_allocate_columns (self, width);
@@ -501,6 +532,8 @@ gtk_column_view_allocate (GtkWidget *widget,
 
   dx = (_gtk_widget_get_direction (widget) != GTK_TEXT_DIR_RTL) ? -x : width - full_width + x;
 
+  cell_range_changed = gtk_column_view_update_cell_range (self, -dx, width);
+
   gtk_widget_allocate (self->header, full_width, header_height, -1,
                        gsk_transform_translate (NULL, &GRAPHENE_POINT_INIT (dx, 0)));
 
@@ -508,6 +541,21 @@ gtk_column_view_allocate (GtkWidget *widget,
                        full_width, height - header_height, -1,
                        gsk_transform_translate (NULL, &GRAPHENE_POINT_INIT (dx, header_height)));
 
+  /* Rows that kept their size were not allocated again above, so
+   * they need to be told about the new range. Queueing a resize on
+   * them here would be too late for this allocation.
+   */
+  if (cell_range_changed)
+    {
+      for (child = _gtk_widget_get_first_child (GTK_WIDGET (self->listview));
+           child != NULL;
+           child = _gtk_widget_get_next_sibling (child))
+        {
+          if (GTK_IS_COLUMN_VIEW_ROW_WIDGET (child))
+            gtk_column_view_row_widget_update_cells (GTK_COLUMN_VIEW_ROW_WIDGET (child));
+        }
+    }
+
   gtk_adjustment_configure (self->hadjustment,  x, 0, full_width, width * 0.1, width * 0.9, width);
 }
 
@@ -1516,6 +1564,8 @@ gtk_column_view_init (GtkColumnView *self)
   gtk_widget_set_overflow (GTK_WIDGET (self), GTK_OVERFLOW_HIDDEN);
 
   self->reorderable = TRUE;
+  self->cell_range_start = 0;
+  self->cell_range_end = -1;
 }
 
 /**
@@ -1846,6 +1896,28 @@ gtk_column_view_get_focus_column (GtkColumnView *self)
   return self->focus_column;
 }
 
+/*<private>
+ * gtk_column_view_is_in_cell_range:
+ * @self: a column view
+ * @x: start of the range
+ * @width: width of the range
+ *
+ * Checks if cells covering the given horizontal range need to be
+ * laid out or if they are too far out of view.
+ *
+ * Returns: %TRUE if the range is close enough to the visible area
+ */
+gboolean
+gtk_column_view_is_in_cell_range (GtkColumnView *self,
+                                  int            x,
+                                  int            width)
+{
+  if (self->cell_range_start > self->cell_range_end)
+    return TRUE;
+
+  return x < self->cell_range_end && x + width > self->cell_range_start;
+}
+
 void
 gtk_column_view_measure_across (GtkColumnView *self,
                                 int           *minimum,
@@ -527,6 +527,8 @@ gtk_column_view_column_create_cells (GtkColumnViewColumn *self)
     return;
 
   list = gtk_column_view_get_list_view (GTK_COLUMN_VIEW (self->view));
+  /* spare rows are not children of the list, they'd miss the new cells */
+  gtk_list_item_manager_clear_spare_items (gtk_list_base_get_manager (GTK_LIST_BASE (list)));
   for (row = gtk_widget_get_first_child (GTK_WIDGET (list));
        row != NULL;
        row = gtk_widget_get_next_sibling (row))
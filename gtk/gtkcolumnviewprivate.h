@@ -35,6 +35,10 @@ void                    gtk_column_view_measure_across          (GtkColumnView
                                                                  int                    *minimum,
                                                                  int                    *natural);
 
+gboolean                gtk_column_view_is_in_cell_range        (GtkColumnView          *self,
+                                                                 int                     x,
+                                                                 int                     width);
+
 void                    gtk_column_view_distribute_width        (GtkColumnView          *self,
                                                                  int                     width,
                                                                  GtkRequestedSize       *sizes);
@@ -65,6 +65,26 @@ gtk_column_view_row_child_get_column (GtkWidget *child)
   g_return_val_if_reached (NULL);
 }
 
+static gboolean
+gtk_column_view_row_widget_is_child_in_view (GtkColumnViewRowWidget *self,
+                                             GtkColumnView          *view,
+                                             GtkWidget              *child)
+{
+  int col_x, col_width;
+
+  /* Titles are cheap and needed for interacting with the header */
+  if (gtk_column_view_row_widget_is_header (self))
+    return TRUE;
+
+  if (child == gtk_widget_get_focus_child (GTK_WIDGET (self)))
+    return TRUE;
+
+  gtk_column_view_column_get_header_allocation (gtk_column_view_row_child_get_column (child),
+                                                &col_x, &col_width);
+
+  return gtk_column_view_is_in_cell_range (view, col_x, col_width);
+}
+
 static GtkWidget *
 gtk_column_view_row_widget_find_child (GtkColumnViewRowWidget *self,
                                        GtkColumnViewColumn    *column)
@@ -413,6 +433,8 @@ gtk_column_view_row_widget_measure_along (GtkColumnViewRowWidget *self,
       int child_min_baseline = -1;
       int child_nat_baseline = -1;
 
+      /* Cells out of view count too, so scrolling them into view
+       * does not need to change the row height */
       if (!gtk_widget_should_layout (child))
         continue;
 
@@ -460,14 +482,16 @@ gtk_column_view_row_widget_measure (GtkWidget      *widget,
 }
 
 static void
-gtk_column_view_row_widget_allocate (GtkWidget *widget,
-                                     int        width,
-                                     int        height,
-                                     int        baseline)
+gtk_column_view_row_widget_allocate_cells (GtkColumnViewRowWidget *self,
+                                           int                     height,
+                                           int                     baseline)
 {
+  GtkColumnView *view;
   GtkWidget *child;
 
-  for (child = _gtk_widget_get_first_child (widget);
+  view = gtk_column_view_row_widget_get_column_view (self);
+
+  for (child = _gtk_widget_get_first_child (GTK_WIDGET (self));
        child != NULL;
        child = _gtk_widget_get_next_sibling (child))
     {
@@ -477,6 +501,14 @@ gtk_column_view_row_widget_allocate (GtkWidget *widget,
       if (!gtk_widget_should_layout (child))
         continue;
 
+      if (!gtk_column_view_row_widget_is_child_in_view (self, view, child))
+        {
+          gtk_widget_set_child_visible (child, FALSE);
+          continue;
+        }
+
+      gtk_widget_set_child_visible (child, TRUE);
+
       column = gtk_column_view_row_child_get_column (child);
       gtk_column_view_column_get_header_allocation (column, &col_x, &col_width);
 
@@ -486,6 +518,32 @@ gtk_column_view_row_widget_allocate (GtkWidget *widget,
     }
 }
 
+static void
+gtk_column_view_row_widget_allocate (GtkWidget *widget,
+                                     int        width,
+                                     int        height,
+                                     int        baseline)
+{
+  gtk_column_view_row_widget_allocate_cells (GTK_COLUMN_VIEW_ROW_WIDGET (widget), height, baseline);
+}
+
+/* Called by the column view when its cell range changed after the row
+ * was allocated. Cells that come into view get the height of the row,
+ * the row is not measured again for them.
+ */
+void
+gtk_column_view_row_widget_update_cells (GtkColumnViewRowWidget *self)
+{
+  GtkWidget *widget = GTK_WIDGET (self);
+
+  if (!gtk_widget_should_layout (widget))
+    return;
+
+  gtk_column_view_row_widget_allocate_cells (self,
+                                             gtk_widget_get_height (widget),
+                                             gtk_widget_get_baseline (widget));
+}
+
 static void
 add_arrow_bindings (GtkWidgetClass   *widget_class,
 		    guint             keysym,
@@ -56,5 +56,7 @@ void                    gtk_column_view_row_widget_reorder_child        (GtkColu
 void                    gtk_column_view_row_widget_remove_child         (GtkColumnViewRowWidget *self,
                                                                          GtkWidget              *child);
 
+void                    gtk_column_view_row_widget_update_cells         (GtkColumnViewRowWidget *self);
+
 G_END_DECLS
 
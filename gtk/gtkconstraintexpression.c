@@ -24,6 +24,8 @@
 #include "gtkconstraintexpressionprivate.h"
 #include "gtkconstraintsolverprivate.h"
 
+#include <string.h>
+
 /* {{{ Variables */
 
 typedef enum {
@@ -371,8 +373,10 @@ gtk_constraint_variable_is_dummy (const GtkConstraintVariable *variable)
  * A set of variables.
  */
 struct _GtkConstraintVariableSet {
-  /* List<Variable>, owns a reference */
-  GSequence *set;
+  /* Array<Variable>, sorted by id; owns a reference */
+  GtkConstraintVariable **vars;
+  guint n_vars;
+  guint n_allocated;
 
   /* Age of the set, to guard against mutations while iterating */
   gint64 age;
@@ -387,10 +391,14 @@ struct _GtkConstraintVariableSet {
 void
 gtk_constraint_variable_set_free (GtkConstraintVariableSet *set)
 {
+  guint i;
+
   g_return_if_fail (set != NULL);
 
-  g_sequence_free (set->set);
+  for (i = 0; i < set->n_vars; i++)
+    gtk_constraint_variable_unref (set->vars[i]);
 
+  g_free (set->vars);
   g_free (set);
 }
 
@@ -406,24 +414,45 @@ gtk_constraint_variable_set_new (void)
 {
   GtkConstraintVariableSet *res = g_new (GtkConstraintVariableSet, 1);
 
-  res->set = g_sequence_new ((GDestroyNotify) gtk_constraint_variable_unref);
+  res->vars = NULL;
+  res->n_vars = 0;
+  res->n_allocated = 0;
 
   res->age = 0;
 
   return res;
 }
 
-static int
-sort_by_variable_id (gconstpointer a,
-                     gconstpointer b,
-                     gpointer      data)
+/* Returns the position of @variable in @set, or the position
+ * it should be inserted at if it is not in the set
+ */
+static guint
+gtk_constraint_variable_set_search (GtkConstraintVariableSet *set,
+                                    const GtkConstraintVariable *variable,
+                                    gboolean *found)
 {
-  const GtkConstraintVariable *va = a, *vb = b;
+  guint lo = 0, hi = set->n_vars;
+
+  while (lo < hi)
+    {
+      guint mid = lo + (hi - lo) / 2;
+      guint64 id = set->vars[mid]->_id;
+
+      if (id == variable->_id)
+        {
+          *found = TRUE;
+          return mid;
+        }
 
-  if (va == vb)
-    return 0;
+      if (id < variable->_id)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
 
-  return va->_id - vb->_id;
+  *found = FALSE;
+
+  return lo;
 }
 
 /*< private >
@@ -444,17 +473,23 @@ gboolean
 gtk_constraint_variable_set_add (GtkConstraintVariableSet *set,
                                  GtkConstraintVariable *variable)
 {
-  GSequenceIter *iter;
+  gboolean found;
+  guint pos;
+
+  pos = gtk_constraint_variable_set_search (set, variable, &found);
+  if (found)
+    return FALSE;
 
-  iter = g_sequence_search (set->set, variable, sort_by_variable_id, NULL);
-  if (!g_sequence_iter_is_end (iter))
+  if (set->n_vars == set->n_allocated)
     {
-      GtkConstraintVariable *v = g_sequence_get (iter);
-      if (v->_id == variable->_id)
-        return FALSE;
+      set->n_allocated = MAX (set->n_allocated * 2, 4);
+      set->vars = g_renew (GtkConstraintVariable *, set->vars, set->n_allocated);
     }
 
-  g_sequence_insert_before (iter, gtk_constraint_variable_ref (variable));
+  memmove (set->vars + pos + 1, set->vars + pos,
+           (set->n_vars - pos) * sizeof (GtkConstraintVariable *));
+  set->vars[pos] = gtk_constraint_variable_ref (variable);
+  set->n_vars += 1;
 
   set->age += 1;
 
@@ -477,18 +512,22 @@ gboolean
 gtk_constraint_variable_set_remove (GtkConstraintVariableSet *set,
                                     GtkConstraintVariable *variable)
 {
-  GSequenceIter *iter;
+  gboolean found;
+  guint pos;
 
-  iter = g_sequence_lookup (set->set, variable, sort_by_variable_id, NULL);
-  if (iter != NULL)
-    {
-      g_sequence_remove (iter);
-      set->age += 1;
+  pos = gtk_constraint_variable_set_search (set, variable, &found);
+  if (!found)
+    return FALSE;
 
-      return TRUE;
-    }
+  gtk_constraint_variable_unref (set->vars[pos]);
 
-  return FALSE;
+  set->n_vars -= 1;
+  memmove (set->vars + pos, set->vars + pos + 1,
+           (set->n_vars - pos) * sizeof (GtkConstraintVariable *));
+
+  set->age += 1;
+
+  return TRUE;
 }
 
 /*< private >
@@ -502,19 +541,20 @@ gtk_constraint_variable_set_remove (GtkConstraintVariableSet *set,
 int
 gtk_constraint_variable_set_size (GtkConstraintVariableSet *set)
 {
-  return g_sequence_get_length (set->set);
+  return set->n_vars;
 }
 
 gboolean
 gtk_constraint_variable_set_is_empty (GtkConstraintVariableSet *set)
 {
-  return g_sequence_is_empty (set->set);
+  return set->n_vars == 0;
 }
 
 gboolean
 gtk_constraint_variable_set_is_singleton (GtkConstraintVariableSet *set)
 {
-  return g_sequence_iter_next (g_sequence_get_begin_iter (set->set)) == g_sequence_get_end_iter (set->set);
+  /* An empty set has no other variable either */
+  return set->n_vars <= 1;
 }
 
 /*< private >
@@ -525,7 +565,7 @@ gtk_constraint_variable_set_is_singleton (GtkConstraintVariableSet *set)
 /* Keep in sync with GtkConstraintVariableSetIter */
 typedef struct {
   GtkConstraintVariableSet *set;
-  GSequenceIter *iter;
+  gsize pos;
   gint64 age;
 } RealVariableSetIter;
 
@@ -548,7 +588,7 @@ gtk_constraint_variable_set_iter_init (GtkConstraintVariableSetIter *iter,
   g_return_if_fail (set != NULL);
 
   riter->set = set;
-  riter->iter = g_sequence_get_begin_iter (set->set);
+  riter->pos = 0;
   riter->age = set->age;
 }
 
@@ -572,11 +612,11 @@ gtk_constraint_variable_set_iter_next (GtkConstraintVariableSetIter *iter,
 
   g_assert (riter->age == riter->set->age);
 
-  if (g_sequence_iter_is_end (riter->iter))
+  if (riter->pos >= riter->set->n_vars)
     return FALSE;
 
-  *variable_p = g_sequence_get (riter->iter);
-  riter->iter = g_sequence_iter_next (riter->iter);
+  *variable_p = riter->set->vars[riter->pos];
+  riter->pos += 1;
 
   return TRUE;
 }
@@ -626,69 +666,107 @@ gtk_constraint_variable_pair_free (GtkConstraintVariablePair *pair)
 
 /*< private >
  * Term:
- * @variable: a `GtkConstraintVariable`
+ * @variable: (nullable): a `GtkConstraintVariable`, or %NULL if the
+ *   term has been removed
  * @coefficient: the coefficient applied to the @variable
- * @next: the next term in the expression
- * @prev: the previous term in the expression;
  *
  * A tuple of (@variable, @coefficient) in an equation.
  *
  * The term acquires a reference on the variable.
  */
-typedef struct _Term Term;
-
-struct _Term {
+typedef struct {
   GtkConstraintVariable *variable;
   double coefficient;
+} Term;
+
+/* Rows with more terms than this get an index to look up terms */
+#define TERMS_INDEX_THRESHOLD 16
+
+struct _GtkConstraintExpression
+{
+  double constant;
+
+  /* Array<Term>, in insertion order; removed terms leave a hole
+   * behind until the array is compacted, so that positions in the
+   * index stay valid
+   */
+  Term *terms;
+  guint n_terms;
+  guint n_allocated;
+  guint n_live_terms;
 
-  Term *next;
-  Term *prev;
+  /* HashTable<Variable, position + 1>; only used by large rows, like
+   * the objective function, when scanning the terms gets too slow
+   */
+  GHashTable *index;
+
+  /* Used by GtkConstraintExpressionIter to guard against changes
+   * in the expression while iterating
+   */
+  gint64 age;
 };
 
-static Term *
-term_new (GtkConstraintVariable *variable,
-          double coefficient)
+static void
+gtk_constraint_expression_rebuild_index (GtkConstraintExpression *self)
 {
-  Term *res = g_new (Term, 1);
+  guint i;
 
-  res->variable = gtk_constraint_variable_ref (variable);
-  res->coefficient = coefficient;
-  res->next = res->prev = NULL;
+  if (self->index == NULL)
+    self->index = g_hash_table_new (NULL, NULL);
+  else
+    g_hash_table_remove_all (self->index);
 
-  return res;
+  for (i = 0; i < self->n_terms; i++)
+    {
+      if (self->terms[i].variable != NULL)
+        g_hash_table_insert (self->index, self->terms[i].variable, GUINT_TO_POINTER (i + 1));
+    }
 }
 
-static void
-term_free (gpointer data)
+static Term *
+gtk_constraint_expression_find_term (const GtkConstraintExpression *self,
+                                     const GtkConstraintVariable *variable)
 {
-  Term *term = data;
+  guint i;
 
-  if (term == NULL)
-    return;
+  if (self->index != NULL)
+    {
+      i = GPOINTER_TO_UINT (g_hash_table_lookup (self->index, variable));
+
+      return i != 0 ? &self->terms[i - 1] : NULL;
+    }
 
-  gtk_constraint_variable_unref (term->variable);
+  for (i = 0; i < self->n_terms; i++)
+    {
+      if (self->terms[i].variable == variable)
+        return &self->terms[i];
+    }
 
-  g_free (term);
+  return NULL;
 }
 
-struct _GtkConstraintExpression
+/* Squeezes out the holes left by removed terms */
+static void
+gtk_constraint_expression_compact (GtkConstraintExpression *self)
 {
-  double constant;
+  guint i, j;
 
-  /* HashTable<Variable, Term>; the key is the term's variable,
-   * and the value is owned by the hash table
-   */
-  GHashTable *terms;
+  for (i = 0, j = 0; i < self->n_terms; i++)
+    {
+      if (self->terms[i].variable == NULL)
+        continue;
 
-  /* List of terms, in insertion order */
-  Term *first_term;
-  Term *last_term;
+      if (i != j)
+        self->terms[j] = self->terms[i];
 
-  /* Used by GtkConstraintExpressionIter to guard against changes
-   * in the expression while iterating
-   */
-  gint64 age;
-};
+      j++;
+    }
+
+  self->n_terms = j;
+
+  if (self->index != NULL)
+    gtk_constraint_expression_rebuild_index (self);
+}
 
 /*< private >
  * gtk_constraint_expression_add_term:
@@ -708,27 +786,29 @@ gtk_constraint_expression_add_term (GtkConstraintExpression *self,
 {
   Term *term;
 
-  if (self->terms == NULL)
+  if (self->n_terms == self->n_allocated)
     {
-      g_assert (self->first_term == NULL && self->last_term == NULL);
-      self->terms = g_hash_table_new_full (NULL, NULL,
-                                           NULL,
-                                           term_free);
-    }
-
-  term = term_new (variable, coefficient);
-
-  g_hash_table_insert (self->terms, term->variable, term);
+      if (self->n_terms > 2 * self->n_live_terms)
+        gtk_constraint_expression_compact (self);
 
-  if (self->first_term == NULL)
-    self->first_term = term;
+      if (self->n_terms == self->n_allocated)
+        {
+          self->n_allocated = MAX (self->n_allocated * 2, 4);
+          self->terms = g_renew (Term, self->terms, self->n_allocated);
+        }
+    }
 
-  term->prev = self->last_term;
+  term = &self->terms[self->n_terms];
+  term->variable = gtk_constraint_variable_ref (variable);
+  term->coefficient = coefficient;
 
-  if (self->last_term != NULL)
-    self->last_term->next = term;
+  self->n_terms += 1;
+  self->n_live_terms += 1;
 
-  self->last_term = term;
+  if (self->index != NULL)
+    g_hash_table_insert (self->index, variable, GUINT_TO_POINTER (self->n_terms));
+  else if (self->n_live_terms > TERMS_INDEX_THRESHOLD)
+    gtk_constraint_expression_rebuild_index (self);
 
   /* Increase the age of the expression, so that we can catch
    * mutations from within an iteration over the terms
@@ -740,46 +820,22 @@ static void
 gtk_constraint_expression_remove_term (GtkConstraintExpression *self,
                                        GtkConstraintVariable *variable)
 {
-  Term *term, *iter;
-
-  if (self->terms == NULL)
-    return;
+  Term *term;
 
-  term = g_hash_table_lookup (self->terms, variable);
+  term = gtk_constraint_expression_find_term (self, variable);
   if (term == NULL)
     return;
 
-  /* Keep the variable alive for the duration of the function */
-  gtk_constraint_variable_ref (variable);
+  if (self->index != NULL)
+    g_hash_table_remove (self->index, variable);
 
-  iter = self->first_term;
-  while (iter != NULL)
-    {
-      Term *next = iter->next;
-      Term *prev = iter->prev;
+  term->variable = NULL;
+  term->coefficient = 0.0;
+  self->n_live_terms -= 1;
 
-      if (iter == term)
-        {
-          if (prev != NULL)
-            prev->next = next;
-          if (next != NULL)
-            next->prev = prev;
-
-          if (iter == self->first_term)
-            self->first_term = next;
-          if (iter == self->last_term)
-            self->last_term = prev;
-
-          iter->next = NULL;
-          iter->prev = NULL;
-
-          break;
-        }
-
-      iter = next;
-    }
-
-  g_hash_table_remove (self->terms, variable);
+  /* Drop the holes at the end right away */
+  while (self->n_terms > 0 && self->terms[self->n_terms - 1].variable == NULL)
+    self->n_terms -= 1;
 
   gtk_constraint_variable_unref (variable);
 
@@ -801,8 +857,10 @@ gtk_constraint_expression_new (double constant)
 
   res->age = 0;
   res->terms = NULL;
-  res->first_term = NULL;
-  res->last_term = NULL;
+  res->n_terms = 0;
+  res->n_allocated = 0;
+  res->n_live_terms = 0;
+  res->index = NULL;
   res->constant = constant;
 
   return res;
@@ -847,13 +905,19 @@ static void
 gtk_constraint_expression_clear (gpointer data)
 {
   GtkConstraintExpression *self = data;
+  guint i;
 
-  g_clear_pointer (&self->terms, g_hash_table_unref);
+  for (i = 0; i < self->n_terms; i++)
+    g_clear_pointer (&self->terms[i].variable, gtk_constraint_variable_unref);
+
+  g_clear_pointer (&self->terms, g_free);
+  g_clear_pointer (&self->index, g_hash_table_unref);
 
   self->age = 0;
   self->constant = 0.0;
-  self->first_term = NULL;
-  self->last_term = NULL;
+  self->n_terms = 0;
+  self->n_allocated = 0;
+  self->n_live_terms = 0;
 }
 
 /*< private >
@@ -879,6 +943,8 @@ gtk_constraint_expression_unref (GtkConstraintExpression *expression)
 gboolean
 gtk_constraint_expression_is_constant (const GtkConstraintExpression *expression)
 {
+  /* An expression that had all its terms removed is not considered
+   * constant, the solver relies on that when removing constraints */
   return expression->terms == NULL;
 }
 
@@ -918,16 +984,22 @@ GtkConstraintExpression *
 gtk_constraint_expression_clone (GtkConstraintExpression *expression)
 {
   GtkConstraintExpression *res;
-  Term *iter;
+  guint i;
 
   res = gtk_constraint_expression_new (expression->constant);
 
-  iter = expression->first_term;
-  while (iter != NULL)
+  if (expression->n_live_terms > 0)
+    {
+      res->n_allocated = expression->n_live_terms;
+      res->terms = g_new (Term, res->n_allocated);
+    }
+
+  for (i = 0; i < expression->n_terms; i++)
     {
-      gtk_constraint_expression_add_term (res, iter->variable, iter->coefficient);
+      const Term *t = &expression->terms[i];
 
-      iter = iter->next;
+      if (t->variable != NULL)
+        gtk_constraint_expression_add_term (res, t->variable, t->coefficient);
     }
 
   return res;
@@ -960,9 +1032,9 @@ gtk_constraint_expression_add_variable (GtkConstraintExpression *expression,
                                         GtkConstraintSolver *solver)
 {
   /* If the expression already contains the variable, update the coefficient */
-  if (expression->terms != NULL)
+  if (expression->n_live_terms != 0)
     {
-      Term *t = g_hash_table_lookup (expression->terms, variable);
+      Term *t = gtk_constraint_expression_find_term (expression, variable);
 
       if (t != NULL)
         {
@@ -1029,15 +1101,12 @@ gtk_constraint_expression_set_variable (GtkConstraintExpression *expression,
                                         GtkConstraintVariable *variable,
                                         double coefficient)
 {
-  if (expression->terms != NULL)
-    {
-      Term *t = g_hash_table_lookup (expression->terms, variable);
+  Term *t = gtk_constraint_expression_find_term (expression, variable);
 
-      if (t != NULL)
-        {
-          t->coefficient = coefficient;
-          return;
-        }
+  if (t != NULL)
+    {
+      t->coefficient = coefficient;
+      return;
     }
 
   gtk_constraint_expression_add_term (expression, variable, coefficient);
@@ -1076,21 +1145,21 @@ gtk_constraint_expression_add_expression (GtkConstraintExpression *a_expr,
                                           GtkConstraintVariable *subject,
                                           GtkConstraintSolver *solver)
 {
-  Term *iter;
+  guint i;
 
   a_expr->constant += (n * b_expr->constant);
 
-  iter = b_expr->last_term;
-  while (iter != NULL)
+  for (i = b_expr->n_terms; i > 0; i--)
     {
-      Term *next = iter->prev;
+      const Term *t = &b_expr->terms[i - 1];
+
+      if (t->variable == NULL)
+        continue;
 
       gtk_constraint_expression_add_variable (a_expr,
-                                              iter->variable, n * iter->coefficient,
+                                              t->variable, n * t->coefficient,
                                               subject,
                                               solver);
-
-      iter = next;
     }
 }
 
@@ -1196,21 +1265,12 @@ GtkConstraintExpression *
 gtk_constraint_expression_multiply_by (GtkConstraintExpression *expression,
                                        double factor)
 {
-  GHashTableIter iter;
-  gpointer value_p;
+  guint i;
 
   expression->constant *= factor;
 
-  if (expression->terms == NULL)
-    return expression;
-
-  g_hash_table_iter_init (&iter, expression->terms);
-  while (g_hash_table_iter_next (&iter, NULL, &value_p))
-    {
-      Term *t = value_p;
-
-      t->coefficient *= factor;
-    }
+  for (i = 0; i < expression->n_terms; i++)
+    expression->terms[i].coefficient *= factor;
 
   return expression;
 }
@@ -1269,7 +1329,7 @@ gtk_constraint_expression_new_subject (GtkConstraintExpression *expression,
 
   g_assert (!gtk_constraint_expression_is_constant (expression));
 
-  term = g_hash_table_lookup (expression->terms, subject);
+  term = gtk_constraint_expression_find_term (expression, subject);
   g_assert (term != NULL);
   g_assert (!G_APPROX_VALUE (term->coefficient, 0.0, 0.001));
 
@@ -1334,10 +1394,7 @@ gtk_constraint_expression_get_coefficient (GtkConstraintExpression *expression,
   g_return_val_if_fail (expression != NULL, 0.0);
   g_return_val_if_fail (variable != NULL, 0.0);
 
-  if (expression->terms == NULL)
-    return 0.0;
-
-  term = g_hash_table_lookup (expression->terms, variable);
+  term = gtk_constraint_expression_find_term (expression, variable);
   if (term == NULL)
     return 0.0;
 
@@ -1365,9 +1422,9 @@ gtk_constraint_expression_substitute_out (GtkConstraintExpression *expression,
                                           GtkConstraintSolver *solver)
 {
   double multiplier;
-  Term *iter;
+  guint i;
 
-  if (expression->terms == NULL)
+  if (expression->n_live_terms == 0)
     return;
 
   multiplier = gtk_constraint_expression_get_coefficient (expression, out_var);
@@ -1375,18 +1432,19 @@ gtk_constraint_expression_substitute_out (GtkConstraintExpression *expression,
 
   expression->constant = expression->constant + multiplier * expr->constant;
 
-  iter = expr->first_term;
-  while (iter != NULL)
+  for (i = 0; i < expr->n_terms; i++)
     {
-      GtkConstraintVariable *clv = iter->variable;
-      double coeff = iter->coefficient;
-      Term *next = iter->next;
+      GtkConstraintVariable *clv = expr->terms[i].variable;
+      double coeff = expr->terms[i].coefficient;
+      Term *t;
 
-      if (expression->terms != NULL &&
-          g_hash_table_contains (expression->terms, clv))
+      if (clv == NULL)
+        continue;
+
+      t = gtk_constraint_expression_find_term (expression, clv);
+      if (t != NULL)
         {
-          double old_coefficient = gtk_constraint_expression_get_coefficient (expression, clv);
-          double new_coefficient = old_coefficient + multiplier * coeff;
+          double new_coefficient = t->coefficient + multiplier * coeff;
 
           if (G_APPROX_VALUE (new_coefficient, 0.0, 0.001))
             {
@@ -1396,17 +1454,15 @@ gtk_constraint_expression_substitute_out (GtkConstraintExpression *expression,
               gtk_constraint_expression_remove_term (expression, clv);
             }
           else
-            gtk_constraint_expression_set_variable (expression, clv, new_coefficient);
+            t->coefficient = new_coefficient;
         }
       else
         {
-          gtk_constraint_expression_set_variable (expression, clv, multiplier * coeff);
+          gtk_constraint_expression_add_term (expression, clv, multiplier * coeff);
 
           if (solver != NULL)
             gtk_constraint_solver_note_added_variable (solver, clv, subject);
         }
-
-      iter = next;
     }
 }
 
@@ -1422,23 +1478,20 @@ gtk_constraint_expression_substitute_out (GtkConstraintExpression *expression,
 GtkConstraintVariable *
 gtk_constraint_expression_get_pivotable_variable (GtkConstraintExpression *expression)
 {
-  Term *iter;
+  guint i;
 
-  if (expression->terms == NULL)
+  if (expression->n_live_terms == 0)
     {
       g_critical ("Expression %p is a constant", expression);
       return NULL;
     }
 
-  iter = expression->first_term;
-  while (iter != NULL)
+  for (i = 0; i < expression->n_terms; i++)
     {
-      Term *next = iter->next;
+      GtkConstraintVariable *variable = expression->terms[i].variable;
 
-      if (gtk_constraint_variable_is_pivotable (iter->variable))
-        return iter->variable;
-
-      iter = next;
+      if (variable != NULL && gtk_constraint_variable_is_pivotable (variable))
+        return variable;
     }
 
   return NULL;
@@ -1459,7 +1512,7 @@ gtk_constraint_expression_to_string (const GtkConstraintExpression *expression)
 {
   gboolean needs_plus = FALSE;
   GString *buf;
-  Term *iter;
+  guint i;
 
   if (expression == NULL)
     return g_strdup ("<null>");
@@ -1470,33 +1523,32 @@ gtk_constraint_expression_to_string (const GtkConstraintExpression *expression)
     {
       g_string_append_printf (buf, "%g", expression->constant);
 
-      if (expression->terms != NULL)
+      if (expression->n_live_terms != 0)
         needs_plus = TRUE;
     }
 
-  if (expression->terms == NULL)
-    return g_string_free (buf, FALSE);
-
-  iter = expression->first_term;
-  while (iter != NULL)
+  for (i = 0; i < expression->n_terms; i++)
     {
-      char *str = gtk_constraint_variable_to_string (iter->variable);
-      Term *next = iter->next;
+      const Term *t = &expression->terms[i];
+      char *str;
+
+      if (t->variable == NULL)
+        continue;
+
+      str = gtk_constraint_variable_to_string (t->variable);
 
       if (needs_plus)
         g_string_append (buf, " + ");
 
-      if (G_APPROX_VALUE (iter->coefficient, 1.0, 0.001))
+      if (G_APPROX_VALUE (t->coefficient, 1.0, 0.001))
         g_string_append_printf (buf, "%s", str);
       else
-        g_string_append_printf (buf, "(%g * %s)", iter->coefficient, str);
+        g_string_append_printf (buf, "(%g * %s)", t->coefficient, str);
 
       g_free (str);
 
       if (!needs_plus)
         needs_plus = TRUE;
-
-      iter = next;
     }
 
   return g_string_free (buf, FALSE);
@@ -1505,7 +1557,8 @@ gtk_constraint_expression_to_string (const GtkConstraintExpression *expression)
 /* Keep in sync with GtkConstraintExpressionIter */
 typedef struct {
   GtkConstraintExpression *expression;
-  Term *current;
+  /* Position of the current term, or -1 before the iteration starts */
+  gssize current;
   gint64 age;
 } RealExpressionIter;
 
@@ -1525,7 +1578,7 @@ gtk_constraint_expression_iter_init (GtkConstraintExpressionIter *iter,
   RealExpressionIter *riter = REAL_EXPRESSION_ITER (iter);
 
   riter->expression = expression;
-  riter->current = NULL;
+  riter->current = -1;
   riter->age = expression->age;
 }
 
@@ -1548,20 +1601,25 @@ gtk_constraint_expression_iter_next (GtkConstraintExpressionIter *iter,
 {
   RealExpressionIter *riter = REAL_EXPRESSION_ITER (iter);
 
-  g_assert (riter->age == riter->expression->age);
+  const GtkConstraintExpression *expression = riter->expression;
+  gssize i;
 
-  if (riter->current == NULL)
-    riter->current = riter->expression->first_term;
-  else
-    riter->current = riter->current->next;
+  g_assert (riter->age == expression->age);
 
-  if (riter->current != NULL)
+  for (i = riter->current + 1; i < (gssize) expression->n_terms; i++)
     {
-      *coefficient = riter->current->coefficient;
-      *variable = riter->current->variable;
+      if (expression->terms[i].variable != NULL)
+        {
+          riter->current = i;
+          *coefficient = expression->terms[i].coefficient;
+          *variable = expression->terms[i].variable;
+          return TRUE;
+        }
     }
 
-  return riter->current != NULL;
+  riter->current = -1;
+
+  return FALSE;
 }
 
 /*< private >
@@ -1583,20 +1641,25 @@ gtk_constraint_expression_iter_prev (GtkConstraintExpressionIter *iter,
 {
   RealExpressionIter *riter = REAL_EXPRESSION_ITER (iter);
 
-  g_assert (riter->age == riter->expression->age);
+  const GtkConstraintExpression *expression = riter->expression;
+  gssize i;
 
-  if (riter->current == NULL)
-    riter->current = riter->expression->last_term;
-  else
-    riter->current = riter->current->prev;
+  g_assert (riter->age == expression->age);
 
-  if (riter->current != NULL)
+  for (i = riter->current < 0 ? (gssize) expression->n_terms - 1 : riter->current - 1; i >= 0; i--)
     {
-      *coefficient = riter->current->coefficient;
-      *variable = riter->current->variable;
+      if (expression->terms[i].variable != NULL)
+        {
+          riter->current = i;
+          *coefficient = expression->terms[i].coefficient;
+          *variable = expression->terms[i].variable;
+          return TRUE;
+        }
     }
 
-  return riter->current != NULL;
+  riter->current = -1;
+
+  return FALSE;
 }
 
 typedef enum {
@@ -907,6 +907,41 @@ update_child_constraint (GtkConstraintLayout       *self,
     }
 }
 
+/* gtk_widget_get_preferred_size() starts by measuring the width of
+ * height-for-width children, which is what labels are
+ */
+static void
+prefetch_children (GtkWidget *widget)
+{
+  GtkWidget **children;
+  GtkWidget *child;
+  int n = 0;
+
+  if (!gtk_widget_can_prefetch_measure ())
+    return;
+
+  for (child = _gtk_widget_get_first_child (widget);
+       child != NULL;
+       child = _gtk_widget_get_next_sibling (child))
+    n++;
+
+  if (n < 2)
+    return;
+
+  children = g_newa (GtkWidget *, n);
+  n = 0;
+
+  for (child = _gtk_widget_get_first_child (widget);
+       child != NULL;
+       child = _gtk_widget_get_next_sibling (child))
+    {
+      if (gtk_widget_should_layout (child))
+        children[n++] = child;
+    }
+
+  gtk_widget_prefetch_measure (children, NULL, n, GTK_ORIENTATION_HORIZONTAL);
+}
+
 static void
 gtk_constraint_layout_measure (GtkLayoutManager *manager,
                                GtkWidget        *widget,
@@ -930,6 +965,8 @@ gtk_constraint_layout_measure (GtkLayoutManager *manager,
 
   gtk_constraint_solver_freeze (solver);
 
+  prefetch_children (widget);
+
   /* We measure each child in the layout and impose restrictions on the
    * minimum and natural size, so we can solve the size of the overall
    * layout later on
@@ -22,10 +22,12 @@
 #include "gtkcssstaticstyleprivate.h"
 #include "gtkcssanimatedstyleprivate.h"
 #include "gtkcssstylepropertyprivate.h"
+#include "gtkcsswidgetnodeprivate.h"
 #include "gtkmarshalers.h"
 #include "gtksettingsprivate.h"
 #include "gtktypebuiltins.h"
 #include "gtkprivate.h"
+#include "gtkwidgetprofilerprivate.h"
 #include "gdkprofilerprivate.h"
 
 /*
@@ -1322,10 +1324,18 @@ gtk_css_node_validate_internal (GtkCssNode             *cssnode,
 {
   GtkCssNode *child;
   gboolean bloomed = FALSE;
+  gboolean profiled;
+  GtkWidgetProfilerSpan span;
 
   if (!cssnode->invalid)
     return;
 
+  /* Nodes that don't belong to a widget are counted as part of
+   * the widget they are inside of */
+  profiled = gtk_widget_profiler_is_running () && GTK_IS_CSS_WIDGET_NODE (cssnode);
+  if (profiled)
+    gtk_widget_profiler_begin (&span);
+
   gtk_css_node_ensure_style (cssnode, filter, timestamp);
 
   /* need to set to FALSE then to TRUE here to make it chain up */
@@ -1353,6 +1363,11 @@ gtk_css_node_validate_internal (GtkCssNode             *cssnode,
 
   if (bloomed)
     gtk_css_node_declaration_remove_bloom_hashes (cssnode->decl, filter);
+
+  if (profiled)
+    gtk_widget_profiler_end (&span,
+                             gtk_css_widget_node_get_widget (GTK_CSS_WIDGET_NODE (cssnode)),
+                             GTK_WIDGET_PHASE_CSS);
 }
 
 void
@@ -71,6 +71,10 @@ struct _GtkEntryBufferPrivate
   gsize  normal_text_bytes;
   guint  normal_text_chars;
 
+  /* The last position that was looked up, and its byte offset */
+  guint  cached_char;
+  gsize  cached_byte;
+
   int    max_length;
 };
 
@@ -94,6 +98,46 @@ trash_area (char *area,
     *varea++ = 0;
 }
 
+/* Returns the byte offset of the character at @position.
+ *
+ * Pure ASCII text, which covers most huge pastes like base64 blobs
+ * or JSON, maps directly. Otherwise we scan from whichever is closest
+ * of the start, the end and the last position that was looked up, so
+ * that typing or deleting at the cursor does not scan the whole text.
+ */
+static gsize
+gtk_entry_buffer_normal_offset_to_byte (GtkEntryBufferPrivate *pv,
+                                        guint                  position)
+{
+  const char *base;
+  int delta;
+
+  if (pv->normal_text_bytes == pv->normal_text_chars)
+    return position;
+
+  if (position <= ABS ((int) position - (int) pv->cached_char) &&
+      position <= pv->normal_text_chars - position)
+    {
+      base = pv->normal_text;
+      delta = position;
+    }
+  else if (pv->normal_text_chars - position <= ABS ((int) position - (int) pv->cached_char))
+    {
+      base = pv->normal_text + pv->normal_text_bytes;
+      delta = - (int) (pv->normal_text_chars - position);
+    }
+  else
+    {
+      base = pv->normal_text + pv->cached_byte;
+      delta = (int) position - (int) pv->cached_char;
+    }
+
+  pv->cached_char = position;
+  pv->cached_byte = g_utf8_offset_to_pointer (base, delta) - pv->normal_text;
+
+  return pv->cached_byte;
+}
+
 static const char *
 gtk_entry_buffer_normal_get_text (GtkEntryBuffer *buffer,
                                   gsize          *n_bytes)
@@ -172,7 +216,7 @@ gtk_entry_buffer_normal_insert_text (GtkEntryBuffer *buffer,
     }
 
   /* Actual text insertion */
-  at = g_utf8_offset_to_pointer (pv->normal_text, position) - pv->normal_text;
+  at = gtk_entry_buffer_normal_offset_to_byte (pv, position);
   memmove (pv->normal_text + at + n_bytes, pv->normal_text + at, pv->normal_text_bytes - at);
   memcpy (pv->normal_text + at, chars, n_bytes);
 
@@ -180,6 +224,8 @@ gtk_entry_buffer_normal_insert_text (GtkEntryBuffer *buffer,
   pv->normal_text_bytes += n_bytes;
   pv->normal_text_chars += n_chars;
   pv->normal_text[pv->normal_text_bytes] = '\0';
+  pv->cached_char = position + n_chars;
+  pv->cached_byte = at + n_bytes;
 
   gtk_entry_buffer_emit_inserted_text (buffer, position, chars, n_chars);
   return n_chars;
@@ -225,12 +271,14 @@ gtk_entry_buffer_real_deleted_text (GtkEntryBuffer *buffer,
   GtkEntryBufferPrivate *pv = gtk_entry_buffer_get_instance_private (buffer);
   gsize start, end;
 
-  start = g_utf8_offset_to_pointer (pv->normal_text, position) - pv->normal_text;
-  end = g_utf8_offset_to_pointer (pv->normal_text, position + n_chars) - pv->normal_text;
+  start = gtk_entry_buffer_normal_offset_to_byte (pv, position);
+  end = g_utf8_offset_to_pointer (pv->normal_text + start, n_chars) - pv->normal_text;
 
   memmove (pv->normal_text + start, pv->normal_text + end, pv->normal_text_bytes + 1 - end);
   pv->normal_text_chars -= n_chars;
   pv->normal_text_bytes -= (end - start);
+  pv->cached_char = position;
+  pv->cached_byte = start;
 
   /*
    * Could be a password, make sure we don't leave anything sensitive after
@@ -256,6 +304,8 @@ gtk_entry_buffer_init (GtkEntryBuffer *buffer)
   pv->normal_text_chars = 0;
   pv->normal_text_bytes = 0;
   pv->normal_text_size = 0;
+  pv->cached_char = 0;
+  pv->cached_byte = 0;
 }
 
 static void
@@ -271,6 +321,8 @@ gtk_entry_buffer_finalize (GObject *obj)
       pv->normal_text = NULL;
       pv->normal_text_bytes = pv->normal_text_size = 0;
       pv->normal_text_chars = 0;
+      pv->cached_char = 0;
+      pv->cached_byte = 0;
     }
 
   G_OBJECT_CLASS (gtk_entry_buffer_parent_class)->finalize (obj);
@@ -608,6 +608,58 @@ compute_request_for_child (GridRequest        *request,
     }
 }
 
+/* Lets the text of non-spanning children be measured ahead of time,
+ * see gtk_widget_prefetch_measure().
+ */
+static void
+grid_request_prefetch (GridRequest    *request,
+                       GtkOrientation  orientation,
+                       gboolean        contextual)
+{
+  GtkWidget *child;
+  GtkWidget **children;
+  int *for_sizes;
+  guint n = 0;
+
+  if (!gtk_widget_can_prefetch_measure ())
+    return;
+
+  for (child = _gtk_widget_get_first_child (request->widget);
+       child != NULL;
+       child = _gtk_widget_get_next_sibling (child))
+    n++;
+
+  if (n < 2)
+    return;
+
+  children = g_newa (GtkWidget *, n);
+  for_sizes = g_newa (int, n);
+  n = 0;
+
+  for (child = _gtk_widget_get_first_child (request->widget);
+       child != NULL;
+       child = _gtk_widget_get_next_sibling (child))
+    {
+      GtkGridLayoutChild *grid_child;
+
+      if (!gtk_widget_should_layout (child))
+        continue;
+
+      grid_child = get_grid_child (request->layout, child);
+      if (grid_child->attach[orientation].span != 1)
+        continue;
+
+      children[n] = child;
+      if (contextual)
+        for_sizes[n] = compute_allocation_for_child (request, grid_child, 1 - orientation);
+      else
+        for_sizes[n] = -1;
+      n++;
+    }
+
+  gtk_widget_prefetch_measure (children, for_sizes, n, orientation);
+}
+
 /* Sets requisition to max. of non-spanning children.
  * If contextual is TRUE, requires allocations of
  * lines in the opposite orientation to be set.
@@ -627,6 +679,8 @@ grid_request_non_spanning (GridRequest    *request,
 
   lines = &request->lines[orientation];
 
+  grid_request_prefetch (request, orientation, contextual);
+
   for (child = _gtk_widget_get_first_child (request->widget);
        child != NULL;
        child = _gtk_widget_get_next_sibling (child))
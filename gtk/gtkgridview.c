@@ -30,6 +30,8 @@
 #include "gtktypebuiltins.h"
 #include "gtkwidgetprivate.h"
 
+#include <string.h>
+
 /* Maximum number of list items created by the gridview.
  * For debugging, you can set this to G_MAXUINT to ensure
  * there's always a list item for every row.
@@ -41,6 +43,10 @@
 
 #define DEFAULT_MAX_COLUMNS (7)
 
+/* Items are estimated in batches of this many rows around the anchor,
+ * so models don't have to create all their items at once */
+#define GTK_GRID_VIEW_ESTIMATE_BATCH_ROWS (32)
+
 /**
  * GtkGridView:
  *
@@ -100,8 +106,31 @@ struct _GtkGridView
   /* set in size_allocate */
   guint n_columns;
   double column_width;
+
+  GtkGridViewItemSizeFunc item_size_func;
+  gpointer item_size_data;
+  GDestroyNotify item_size_destroy;
+  /* Array<int>: the estimated height of every item at item_heights_width,
+   * or 0 if the item has not been estimated yet */
+  GArray *item_heights;
+  int item_heights_width;
+  /* Array<RowOffset>: element n sums up the first n rows, for the rows
+   * that are up to date */
+  GArray *row_offsets;
+  guint estimates_n_columns;
+  int estimates_column_width;
+  /* the height used for rows without estimate in the last allocation */
+  int unknown_row_height;
 };
 
+typedef struct
+{
+  /* sum of the heights of the estimated rows */
+  int height;
+  /* number of rows that have not been estimated */
+  guint n_unknown;
+} RowOffset;
+
 struct _GtkGridViewClass
 {
   GtkListBaseClass parent_class;
@@ -184,6 +213,265 @@ column_end (GtkGridView *self,
   return ceil (self->column_width * (col + 1) + (spacing * col));
 }
 
+static gboolean
+gtk_grid_view_has_row_estimates (GtkGridView *self,
+                                 guint        n_columns,
+                                 int          column_width,
+                                 guint        first_row,
+                                 guint        n_rows)
+{
+  return self->item_size_func != NULL &&
+         self->estimates_n_columns == n_columns &&
+         self->estimates_column_width == column_width &&
+         first_row + n_rows < self->row_offsets->len;
+}
+
+/* Gets the summed up height of the estimated rows among @n_rows rows
+ * starting at @first_row, without spacing, and the number of rows
+ * among them that don't have an estimate */
+static void
+gtk_grid_view_get_estimated_rows (GtkGridView *self,
+                                  guint        first_row,
+                                  guint        n_rows,
+                                  int         *height,
+                                  guint       *n_unknown)
+{
+  const RowOffset *start = &g_array_index (self->row_offsets, RowOffset, first_row);
+  const RowOffset *end = &g_array_index (self->row_offsets, RowOffset, first_row + n_rows);
+
+  *height = end->height - start->height;
+  *n_unknown = end->n_unknown - start->n_unknown;
+}
+
+/* Returns the height of @n_rows rows starting at @first_row,
+ * including the spacing between them */
+static int
+gtk_grid_view_get_estimated_rows_height (GtkGridView *self,
+                                         guint        first_row,
+                                         guint        n_rows,
+                                         int          unknown_row_height,
+                                         int          yspacing)
+{
+  guint n_unknown;
+  int height;
+
+  gtk_grid_view_get_estimated_rows (self, first_row, n_rows, &height, &n_unknown);
+
+  return height + (int) n_unknown * unknown_row_height + yspacing * ((int) n_rows - 1);
+}
+
+static void
+gtk_grid_view_invalidate_row_estimates (GtkGridView *self,
+                                        guint        first_row)
+{
+  if (self->row_offsets->len > first_row + 1)
+    g_array_set_size (self->row_offsets, first_row + 1);
+}
+
+static void
+gtk_grid_view_clear_item_heights (GtkGridView *self)
+{
+  g_array_set_size (self->item_heights, 0);
+  self->item_heights_width = 0;
+  gtk_grid_view_invalidate_row_estimates (self, 0);
+}
+
+/* Calls the item size func for the items of the given rows that don't
+ * have an estimate yet and returns the first row that got a new one,
+ * or G_MAXUINT if none did.
+ *
+ * All items are estimated at the same width, and the estimates are
+ * scaled to the current column width when building the rows, so that
+ * resizing the grid does not need to look at any item again.
+ */
+static guint
+gtk_grid_view_estimate_rows (GtkGridView *self,
+                             GListModel  *model,
+                             guint        first_row,
+                             guint        n_rows)
+{
+  guint i, end, first_changed;
+
+  if (self->item_heights_width <= 0)
+    self->item_heights_width = MAX (self->column_width, 1);
+
+  first_changed = G_MAXUINT;
+  end = MIN ((first_row + n_rows) * self->n_columns, self->item_heights->len);
+
+  for (i = first_row * self->n_columns; i < end; i++)
+    {
+      int *height = &g_array_index (self->item_heights, int, i);
+      gpointer item;
+
+      if (*height > 0)
+        continue;
+
+      item = g_list_model_get_item (model, i);
+      *height = MAX (self->item_size_func (item, self->item_heights_width, self->item_size_data), 1);
+      g_object_unref (item);
+
+      first_changed = MIN (first_changed, i / self->n_columns);
+    }
+
+  return first_changed;
+}
+
+static void
+gtk_grid_view_update_row_estimates (GtkGridView *self)
+{
+  GListModel *model;
+  guint n_items, n_rows, row, anchor, first_row, last_row, i;
+  int column_width;
+  double scale;
+
+  if (self->item_size_func == NULL)
+    return;
+
+  column_width = self->column_width;
+  if (self->estimates_n_columns != self->n_columns ||
+      self->estimates_column_width != column_width)
+    {
+      gtk_grid_view_invalidate_row_estimates (self, 0);
+      self->estimates_n_columns = self->n_columns;
+      self->estimates_column_width = column_width;
+    }
+
+  model = G_LIST_MODEL (gtk_list_base_get_model (GTK_LIST_BASE (self)));
+  n_items = model ? g_list_model_get_n_items (model) : 0;
+  n_rows = (n_items + self->n_columns - 1) / self->n_columns;
+  g_array_set_size (self->item_heights, n_items);
+
+  /* Estimate whole batches from the one before the anchor to the one
+   * after the visible rows, rows further away use the unknown height
+   * until they get close */
+  anchor = gtk_list_base_get_anchor (GTK_LIST_BASE (self));
+  if (anchor != GTK_INVALID_LIST_POSITION && n_rows > 0)
+    {
+      row = anchor / self->n_columns;
+      first_row = row / GTK_GRID_VIEW_ESTIMATE_BATCH_ROWS;
+      first_row = (first_row > 0 ? first_row - 1 : 0) * GTK_GRID_VIEW_ESTIMATE_BATCH_ROWS;
+      last_row = (row + GTK_GRID_VIEW_MAX_VISIBLE_ROWS) / GTK_GRID_VIEW_ESTIMATE_BATCH_ROWS + 2;
+      last_row = MIN (last_row * GTK_GRID_VIEW_ESTIMATE_BATCH_ROWS, n_rows);
+      if (first_row < last_row)
+        {
+          row = gtk_grid_view_estimate_rows (self, model, first_row, last_row - first_row);
+          if (row != G_MAXUINT)
+            gtk_grid_view_invalidate_row_estimates (self, row);
+        }
+    }
+
+  scale = (double) column_width / self->item_heights_width;
+
+  gtk_grid_view_invalidate_row_estimates (self, n_rows);
+
+  /* Only rows after the first changed item need to be summed up again */
+  for (row = self->row_offsets->len - 1; row < n_rows; row++)
+    {
+      RowOffset offset = g_array_index (self->row_offsets, RowOffset, row);
+      int height = 0;
+
+      for (i = row * self->n_columns; i < MIN (n_items, (row + 1) * self->n_columns); i++)
+        {
+          int item_height = g_array_index (self->item_heights, int, i);
+
+          if (item_height == 0)
+            {
+              height = 0;
+              break;
+            }
+          height = MAX (height, item_height);
+        }
+
+      if (height > 0)
+        offset.height += MAX (round (height * scale), 1);
+      else
+        offset.n_unknown++;
+      g_array_append_val (self->row_offsets, offset);
+    }
+}
+
+static void
+gtk_grid_view_model_items_changed_cb (GListModel  *model,
+                                      guint        position,
+                                      guint        removed,
+                                      guint        added,
+                                      GtkGridView *self)
+{
+  /* Keep the estimates of the items that are still there */
+  if (position < self->item_heights->len)
+    {
+      guint n_after;
+
+      removed = MIN (removed, self->item_heights->len - position);
+      g_array_remove_range (self->item_heights, position, removed);
+
+      n_after = self->item_heights->len - position;
+      g_array_set_size (self->item_heights, self->item_heights->len + added);
+      memmove (&g_array_index (self->item_heights, int, position + added),
+               &g_array_index (self->item_heights, int, position),
+               n_after * sizeof (int));
+      memset (&g_array_index (self->item_heights, int, position), 0, added * sizeof (int));
+    }
+
+  if (self->estimates_n_columns > 0)
+    gtk_grid_view_invalidate_row_estimates (self, position / self->estimates_n_columns);
+}
+
+/* Returns the offset of the given row of a tile from the top of the tile.
+ * Multirow tiles that were sized from the row estimates use them, otherwise
+ * all rows of a tile are assumed to have the same height.
+ */
+static int
+gtk_grid_view_get_tile_row_offset (GtkGridView *self,
+                                   GtkListTile *tile,
+                                   guint        row,
+                                   int          yspacing)
+{
+  guint n_rows = MAX (tile->n_items / self->n_columns, 1);
+
+  if (row == 0)
+    return 0;
+
+  if (tile->estimated && n_rows > 1)
+    {
+      guint first_row = gtk_list_tile_get_position (self->item_manager, tile) / self->n_columns;
+
+      if (gtk_grid_view_has_row_estimates (self, self->n_columns, self->column_width, first_row, n_rows))
+        return gtk_grid_view_get_estimated_rows_height (self, first_row, row, self->unknown_row_height, yspacing) + yspacing;
+    }
+
+  return row * ((tile->area.height + yspacing) / n_rows);
+}
+
+/* Returns the row of a tile containing the given offset from the top of the tile */
+static guint
+gtk_grid_view_get_tile_row_at (GtkGridView *self,
+                               GtkListTile *tile,
+                               int          y,
+                               int          yspacing)
+{
+  guint n_rows = MAX (tile->n_items / self->n_columns, 1);
+  guint lo, hi;
+
+  if (!tile->estimated || n_rows == 1)
+    return MIN (y / ((tile->area.height + yspacing) / n_rows), n_rows - 1);
+
+  /* the last row whose offset is not after y */
+  lo = 0;
+  hi = n_rows;
+  while (hi - lo > 1)
+    {
+      guint mid = (lo + hi) / 2;
+
+      if (gtk_grid_view_get_tile_row_offset (self, tile, mid, yspacing) <= y)
+        lo = mid;
+      else
+        hi = mid;
+    }
+
+  return lo;
+}
+
 static GtkListTile *
 gtk_grid_view_split (GtkListBase *base,
                      GtkListTile *tile,
@@ -191,33 +479,33 @@ gtk_grid_view_split (GtkListBase *base,
 {
   GtkGridView *self = GTK_GRID_VIEW (base);
   GtkListTile *split;
-  guint col, row_height;
-  int xspacing, yspacing;
+  guint col;
+  int xspacing, yspacing, offset;
 
   gtk_list_base_get_border_spacing (base, &xspacing, &yspacing);
 
-  row_height = (tile->area.height + yspacing) / MAX (tile->n_items / self->n_columns, 1) - yspacing;
-
   /* split off the multirow at the top */
   if (n_items >= self->n_columns)
     {
       guint top_rows = n_items / self->n_columns;
       guint top_items = top_rows * self->n_columns;
 
+      offset = gtk_grid_view_get_tile_row_offset (self, tile, top_rows, yspacing);
       split = tile;
       tile = gtk_list_tile_split (self->item_manager, tile, top_items);
+      tile->estimated = split->estimated;
       gtk_list_tile_set_area (self->item_manager,
                               tile,
                               &(GdkRectangle) {
                                 split->area.x,
-                                split->area.y + (row_height + yspacing) * top_rows,
+                                split->area.y + offset,
                                 split->area.width,
-                                split->area.height - (row_height + yspacing) * top_rows,
+                                split->area.height - offset,
                               });
       gtk_list_tile_set_area_size (self->item_manager,
                                    split,
                                    split->area.width,
-                                   row_height * top_rows + yspacing * (top_rows - 1));
+                                   offset - yspacing);
       n_items -= top_items;
       if (n_items == 0)
         return tile;
@@ -226,19 +514,21 @@ gtk_grid_view_split (GtkListBase *base,
   /* split off the multirow at the bottom */
   if (tile->n_items > self->n_columns)
     {
+      offset = gtk_grid_view_get_tile_row_offset (self, tile, 1, yspacing);
       split = gtk_list_tile_split (self->item_manager, tile, self->n_columns);
+      split->estimated = tile->estimated;
       gtk_list_tile_set_area (self->item_manager,
                               split,
                               &(GdkRectangle) {
                                 tile->area.x,
-                                tile->area.y + row_height + yspacing,
+                                tile->area.y + offset,
                                 tile->area.width,
-                                tile->area.height - row_height - yspacing,
+                                tile->area.height - offset,
                               });
       gtk_list_tile_set_area_size (self->item_manager,
                                    tile,
                                    tile->area.width,
-                                   row_height);
+                                   offset - yspacing);
     }
 
   g_assert (n_items < tile->n_items);
@@ -280,6 +570,8 @@ gtk_grid_view_update_factories_with (GtkGridView        *self,
 {
   GtkListTile *tile;
 
+  gtk_list_item_manager_clear_spare_items (self->item_manager);
+
   for (tile = gtk_list_item_manager_get_first (self->item_manager);
        tile != NULL;
        tile = gtk_rb_tree_node_get_next (tile))
@@ -376,8 +668,13 @@ gtk_grid_view_get_allocation (GtkListBase  *base,
 
   if (tile->n_items > self->n_columns)
     {
-      area->height = (area->height + yspacing) / (tile->n_items / self->n_columns) - yspacing;
-      area->y += (offset / self->n_columns) * (area->height + yspacing);
+      guint row = offset / self->n_columns;
+      int row_start, row_end;
+
+      row_start = gtk_grid_view_get_tile_row_offset (self, tile, row, yspacing);
+      row_end = gtk_grid_view_get_tile_row_offset (self, tile, row + 1, yspacing);
+      area->y += row_start;
+      area->height = row_end - row_start - yspacing;
       offset %= self->n_columns;
     }
 
@@ -436,15 +733,21 @@ gtk_grid_view_get_position_from_allocation (GtkListBase           *base,
       /* offset in y direction */
       if (tile->n_items > self->n_columns)
         {
-          guint rows_in_tile = tile->n_items / self->n_columns;
-          guint row_height = (tile->area.height + yspacing) / rows_in_tile - yspacing;
-          guint row_index = MIN (tile->area.height - 1, y - tile->area.y) / (row_height + yspacing);
+          guint row_index;
+          int row_start;
+
+          row_index = gtk_grid_view_get_tile_row_at (self,
+                                                     tile,
+                                                     MIN (tile->area.height - 1, y - tile->area.y),
+                                                     yspacing);
           pos += self->n_columns * row_index;
 
           if (area)
             {
-              area->y = tile->area.y  + row_index * (row_height + yspacing);
-              area->height = row_height;
+              row_start = gtk_grid_view_get_tile_row_offset (self, tile, row_index, yspacing);
+              area->y = tile->area.y + row_start;
+              area->height = gtk_grid_view_get_tile_row_offset (self, tile, row_index + 1, yspacing)
+                             - row_start - yspacing;
             }
         }
       else
@@ -652,8 +955,8 @@ gtk_grid_view_measure_list (GtkWidget *widget,
   int xspacing, yspacing;
   gboolean measured;
   GArray *heights;
-  guint n_unknown, n_columns;
-  guint i;
+  guint n_unknown, n_columns, n_rows;
+  guint i, row;
 
   gtk_list_base_get_border_spacing (GTK_LIST_BASE (self), &xspacing, &yspacing);
   scroll_policy = gtk_list_base_get_scroll_policy (GTK_LIST_BASE (self), gtk_list_base_get_orientation (GTK_LIST_BASE (self)));
@@ -667,6 +970,7 @@ gtk_grid_view_measure_list (GtkWidget *widget,
   column_size = (for_size + xspacing) / n_columns - xspacing;
 
   i = 0;
+  row = 0;
   row_height = 0;
   measured = FALSE;
   for (tile = gtk_list_item_manager_get_first (self->item_manager);
@@ -697,8 +1001,21 @@ gtk_grid_view_measure_list (GtkWidget *widget,
               height += row_height + yspacing;
               measured = FALSE;
               row_height = 0;
+              row++;
+            }
+          n_rows = i / n_columns;
+          if (n_rows > 0 && gtk_grid_view_has_row_estimates (self, n_columns, column_size, row, n_rows))
+            {
+              guint n_unestimated;
+              int estimated_height;
+
+              gtk_grid_view_get_estimated_rows (self, row, n_rows, &estimated_height, &n_unestimated);
+              height += estimated_height + (int) (n_rows - n_unestimated) * yspacing;
+              n_unknown += n_unestimated;
             }
-          n_unknown += i / n_columns;
+          else
+            n_unknown += n_rows;
+          row += n_rows;
           i %= n_columns;
         }
     }
@@ -710,6 +1027,15 @@ gtk_grid_view_measure_list (GtkWidget *widget,
           g_array_append_val (heights, row_height);
           height += row_height + yspacing;
         }
+      else if (gtk_grid_view_has_row_estimates (self, n_columns, column_size, row, 1))
+        {
+          guint n_unestimated;
+          int estimated_height;
+
+          gtk_grid_view_get_estimated_rows (self, row, 1, &estimated_height, &n_unestimated);
+          height += estimated_height + (int) (1 - n_unestimated) * yspacing;
+          n_unknown += n_unestimated;
+        }
       else
         n_unknown++;
     }
@@ -756,7 +1082,7 @@ gtk_grid_view_size_allocate (GtkWidget *widget,
   GtkOrientation orientation;
   GtkScrollablePolicy scroll_policy;
   int y, xspacing, yspacing;
-  guint i;
+  guint i, pos;
 
   orientation = gtk_list_base_get_orientation (GTK_LIST_BASE (self));
   scroll_policy = gtk_list_base_get_scroll_policy (GTK_LIST_BASE (self), orientation);
@@ -781,6 +1107,7 @@ gtk_grid_view_size_allocate (GtkWidget *widget,
                                                      col_min, col_nat);
   self->column_width = ((orientation == GTK_ORIENTATION_VERTICAL ? width : height) + xspacing) / self->n_columns - xspacing;
   self->column_width = MAX (self->column_width, col_min);
+  gtk_grid_view_update_row_estimates (self);
 
   /* step 2: determine height of known rows */
   heights = g_array_new (FALSE, FALSE, sizeof (int));
@@ -842,11 +1169,13 @@ gtk_grid_view_size_allocate (GtkWidget *widget,
 
   /* step 3: determine height of rows with only unknown items */
   unknown_row_height = gtk_grid_view_get_unknown_row_size (self, heights);
+  self->unknown_row_height = unknown_row_height;
   g_array_free (heights, TRUE);
 
   /* step 4: determine height for remaining rows and set each row's position */
   y = 0;
   i = 0;
+  pos = 0;
   for (tile = gtk_list_item_manager_get_first (self->item_manager);
        tile != NULL;
        tile = gtk_rb_tree_node_get_next (tile))
@@ -857,13 +1186,20 @@ gtk_grid_view_size_allocate (GtkWidget *widget,
                                        y);
       if (tile->n_items >= self->n_columns && tile->widget == NULL)
         {
+          guint n_rows = tile->n_items / self->n_columns;
+
           g_assert (i == 0);
           g_assert (tile->n_items % self->n_columns == 0);
+          tile->estimated = gtk_grid_view_has_row_estimates (self, self->n_columns, self->column_width, pos / self->n_columns, n_rows);
+          if (tile->estimated)
+            row_height = gtk_grid_view_get_estimated_rows_height (self, pos / self->n_columns, n_rows, unknown_row_height, yspacing);
+          else
+            row_height = (unknown_row_height + yspacing) * n_rows - yspacing;
           gtk_list_tile_set_area_size (self->item_manager,
                                        tile,
                                        column_end (self, xspacing, self->n_columns - 1)
                                        - column_start (self, xspacing, 0),
-                                       (unknown_row_height + yspacing) * (tile->n_items / self->n_columns) - yspacing);
+                                       row_height);
           y += tile->area.height + yspacing;
         }
       else
@@ -872,13 +1208,18 @@ gtk_grid_view_size_allocate (GtkWidget *widget,
             {
               /* this case is for the last row - it may not be a full row so it won't
                * be a multirow tile but it may have no widgets either */
+              if (gtk_grid_view_has_row_estimates (self, self->n_columns, self->column_width, pos / self->n_columns, 1))
+                row_height = gtk_grid_view_get_estimated_rows_height (self, pos / self->n_columns, 1, unknown_row_height, yspacing);
+              else
+                row_height = unknown_row_height;
               gtk_list_tile_set_area_size (self->item_manager,
                                            tile,
                                            column_end (self, xspacing, i + tile->n_items - 1) - tile->area.x,
-                                           unknown_row_height);
+                                           row_height);
             }
           i += tile->n_items;
         }
+      pos += tile->n_items;
 
       if (i >= self->n_columns)
         {
@@ -967,9 +1308,31 @@ gtk_grid_view_dispose (GObject *object)
 
   g_clear_object (&self->factory);
 
+  if (gtk_list_base_get_model (GTK_LIST_BASE (self)))
+    g_signal_handlers_disconnect_by_func (gtk_list_base_get_model (GTK_LIST_BASE (self)),
+                                          gtk_grid_view_model_items_changed_cb,
+                                          self);
+
+  if (self->item_size_destroy)
+    self->item_size_destroy (self->item_size_data);
+  self->item_size_func = NULL;
+  self->item_size_data = NULL;
+  self->item_size_destroy = NULL;
+
   G_OBJECT_CLASS (gtk_grid_view_parent_class)->dispose (object);
 }
 
+static void
+gtk_grid_view_finalize (GObject *object)
+{
+  GtkGridView *self = GTK_GRID_VIEW (object);
+
+  g_array_unref (self->item_heights);
+  g_array_unref (self->row_offsets);
+
+  G_OBJECT_CLASS (gtk_grid_view_parent_class)->finalize (object);
+}
+
 static void
 gtk_grid_view_get_property (GObject    *object,
                             guint       property_id,
@@ -1099,6 +1462,7 @@ gtk_grid_view_class_init (GtkGridViewClass *klass)
   widget_class->hide = gtk_grid_view_hide;
 
   gobject_class->dispose = gtk_grid_view_dispose;
+  gobject_class->finalize = gtk_grid_view_finalize;
   gobject_class->get_property = gtk_grid_view_get_property;
   gobject_class->set_property = gtk_grid_view_set_property;
 
@@ -1232,6 +1596,9 @@ gtk_grid_view_init (GtkGridView *self)
   self->min_columns = 1;
   self->max_columns = DEFAULT_MAX_COLUMNS;
   self->n_columns = 1;
+  self->item_heights = g_array_new (FALSE, TRUE, sizeof (int));
+  self->row_offsets = g_array_new (FALSE, TRUE, sizeof (RowOffset));
+  g_array_set_size (self->row_offsets, 1);
 
   gtk_list_base_set_anchor_max_widgets (GTK_LIST_BASE (self),
                                         self->max_columns * GTK_GRID_VIEW_MAX_VISIBLE_ROWS,
@@ -1310,9 +1677,21 @@ gtk_grid_view_set_model (GtkGridView       *self,
   g_return_if_fail (GTK_IS_GRID_VIEW (self));
   g_return_if_fail (model == NULL || GTK_IS_SELECTION_MODEL (model));
 
+  if (model == gtk_list_base_get_model (GTK_LIST_BASE (self)))
+    return;
+
+  if (gtk_list_base_get_model (GTK_LIST_BASE (self)))
+    g_signal_handlers_disconnect_by_func (gtk_list_base_get_model (GTK_LIST_BASE (self)),
+                                          gtk_grid_view_model_items_changed_cb,
+                                          self);
+
   if (!gtk_list_base_set_model (GTK_LIST_BASE (self), model))
     return;
 
+  gtk_grid_view_clear_item_heights (self);
+  if (model)
+    g_signal_connect (model, "items-changed", G_CALLBACK (gtk_grid_view_model_items_changed_cb), self);
+
   gtk_accessible_update_property (GTK_ACCESSIBLE (self),
                                   GTK_ACCESSIBLE_PROPERTY_MULTI_SELECTABLE, GTK_IS_MULTI_SELECTION (model),
                                   -1);
@@ -1473,6 +1852,8 @@ gtk_grid_view_set_single_click_activate (GtkGridView *self,
 
   self->single_click_activate = single_click_activate;
 
+  gtk_list_item_manager_clear_spare_items (self->item_manager);
+
   for (tile = gtk_list_item_manager_get_first (self->item_manager);
        tile != NULL;
        tile = gtk_rb_tree_node_get_next (tile))
@@ -1608,3 +1989,71 @@ gtk_grid_view_scroll_to (GtkGridView        *self,
 
   gtk_list_base_scroll_to (GTK_LIST_BASE (self), pos, flags, scroll);
 }
+
+/**
+ * GtkGridViewItemSizeFunc:
+ * @item: (type GObject): the item from the model
+ * @column_width: the column width to estimate the height for
+ * @user_data: (closure): user data
+ *
+ * Estimates the height an item will need when displayed in a column
+ * of the given width.
+ *
+ * Returns: the estimated height of @item
+ *
+ * Since: 4.22
+ */
+
+/**
+ * gtk_grid_view_set_item_size_func:
+ * @self: a `GtkGridView`
+ * @func: (nullable) (scope notified) (closure user_data) (destroy destroy): the
+ *   function to estimate item sizes
+ * @user_data: user data passed to @func
+ * @destroy: destroy notifier for @user_data
+ *
+ * Sets a function to estimate the size of items.
+ *
+ * The gridview only creates widgets for the items close to the visible
+ * area and has to guess the height of all other rows. By default it
+ * assumes they are as high as the rows it has measured, which makes the
+ * scrollbar jump when items differ a lot in height, like photos with
+ * different aspect ratios.
+ *
+ * If an estimate function is set, the height of a row without widgets
+ * is the largest estimate of its items instead. Only the rows around the
+ * visible area are estimated, in batches as the grid scrolls, so models
+ * that create their items on demand don't need to create all of them.
+ * Rows further away still get the height of the measured rows. The
+ * estimates are cached and only recomputed for items that changed.
+ *
+ * Every item is estimated once, at the column width the grid has when
+ * the item is first needed. When the column width changes, the cached
+ * estimates are scaled with it, so the estimates should be roughly
+ * proportional to the width, as they are for images. Call this function
+ * again to have items estimated at the current width.
+ *
+ * @func should be fast and should not create widgets.
+ *
+ * Since: 4.22
+ */
+void
+gtk_grid_view_set_item_size_func (GtkGridView             *self,
+                                  GtkGridViewItemSizeFunc  func,
+                                  gpointer                 user_data,
+                                  GDestroyNotify           destroy)
+{
+  g_return_if_fail (GTK_IS_GRID_VIEW (self));
+
+  if (self->item_size_destroy)
+    self->item_size_destroy (self->item_size_data);
+
+  self->item_size_func = func;
+  self->item_size_data = user_data;
+  self->item_size_destroy = destroy;
+
+  gtk_grid_view_clear_item_heights (self);
+  self->estimates_n_columns = 0;
+
+  gtk_widget_queue_resize (GTK_WIDGET (self));
+}
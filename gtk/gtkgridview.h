@@ -91,6 +91,16 @@ void            gtk_grid_view_scroll_to                         (GtkGridView
                                                                  GtkListScrollFlags      flags,
                                                                  GtkScrollInfo          *scroll);
 
+typedef int (* GtkGridViewItemSizeFunc) (gpointer item,
+                                         int      column_width,
+                                         gpointer user_data);
+
+GDK_AVAILABLE_IN_4_22
+void            gtk_grid_view_set_item_size_func                (GtkGridView            *self,
+                                                                 GtkGridViewItemSizeFunc func,
+                                                                 gpointer                user_data,
+                                                                 GDestroyNotify          destroy);
+
 
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(GtkGridView, g_object_unref)
 
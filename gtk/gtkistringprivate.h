@@ -60,6 +60,27 @@ istring_set (IString    *str,
   str->n_chars = n_chars;
 }
 
+static inline void
+istring_truncate (IString *str,
+                  guint    n_bytes,
+                  guint    n_chars)
+{
+  g_assert (n_bytes <= str->n_bytes);
+
+  if (!istring_is_inline (str) && n_bytes <= (sizeof str->u.buf - 1))
+    {
+      char *old = str->u.str;
+
+      memcpy (str->u.buf, old, n_bytes);
+      g_free (old);
+    }
+
+  str->n_bytes = n_bytes;
+  str->n_chars = n_chars;
+
+  istring_str (str)[n_bytes] = 0;
+}
+
 static inline gboolean
 istring_empty (IString *str)
 {
@@ -1173,11 +1173,11 @@ get_static_size (GtkLabel       *self,
 
   if (orientation == GTK_ORIENTATION_HORIZONTAL)
     {
-      pango_layout_get_size (layout, natural, NULL);
+      gtk_pango_layout_get_cached_size (layout, natural, NULL, NULL);
       if (self->ellipsize)
         {
           layout = gtk_label_get_measuring_layout (self, layout, 0);
-          pango_layout_get_size (layout, minimum, NULL);
+          gtk_pango_layout_get_cached_size (layout, minimum, NULL, NULL);
           /* yes, Pango ellipsizes even when that needs more space */
           *minimum = MIN (*minimum, *natural);
         }
@@ -1190,8 +1190,7 @@ get_static_size (GtkLabel       *self,
     }
   else
     {
-      pango_layout_get_size (layout, NULL, minimum);
-      *minimum_baseline = pango_layout_get_baseline (layout);
+      gtk_pango_layout_get_cached_size (layout, NULL, minimum, minimum_baseline);
 
       *natural = *minimum;
       *natural_baseline = *minimum_baseline;
@@ -1215,16 +1214,14 @@ get_height_for_width (GtkLabel *self,
     {
       /* Minimum height is assuming infinite width */
       layout = gtk_label_get_measuring_layout (self, NULL, -1);
-      pango_layout_get_size (layout, NULL, minimum_height);
-      baseline = pango_layout_get_baseline (layout);
+      gtk_pango_layout_get_cached_size (layout, NULL, minimum_height, &baseline);
       *minimum_baseline = baseline;
 
       /* Natural height is assuming natural width */
       get_default_widths (self, NULL, &natural_width);
 
       layout = gtk_label_get_measuring_layout (self, layout, natural_width);
-      pango_layout_get_size (layout, NULL, natural_height);
-      baseline = pango_layout_get_baseline (layout);
+      gtk_pango_layout_get_cached_size (layout, NULL, natural_height, &baseline);
       *natural_baseline = baseline;
     }
   else
@@ -1232,12 +1229,11 @@ get_height_for_width (GtkLabel *self,
       /* minimum = natural for any given width */
       layout = gtk_label_get_measuring_layout (self, NULL, width);
 
-      pango_layout_get_size (layout, NULL, &text_height);
+      gtk_pango_layout_get_cached_size (layout, NULL, &text_height, &baseline);
 
       *minimum_height = text_height;
       *natural_height = text_height;
 
-      baseline = pango_layout_get_baseline (layout);
       *minimum_baseline = baseline;
       *natural_baseline = baseline;
     }
@@ -1288,12 +1284,12 @@ get_width_for_height (GtkLabel *self,
     {
       /* Minimum width is as many line breaks as possible */
       layout = gtk_label_get_measuring_layout (self, NULL, MAX (minimum_default, 0));
-      pango_layout_get_size (layout, minimum_width, NULL);
+      gtk_pango_layout_get_cached_size (layout, minimum_width, NULL, NULL);
       *minimum_width = MAX (*minimum_width, minimum_default);
 
       /* Natural width is natural width - or as wide as possible */
       layout = gtk_label_get_measuring_layout (self, layout, natural_default);
-      pango_layout_get_size (layout, natural_width, NULL);
+      gtk_pango_layout_get_cached_size (layout, natural_width, NULL, NULL);
       *natural_width = MAX (*natural_width, *minimum_width);
     }
   else
@@ -1370,6 +1366,29 @@ gtk_label_measure (GtkWidget      *widget,
     *natural_baseline = PANGO_PIXELS_CEIL (*natural_baseline);
 }
 
+/* Returns the layout gtk_label_measure() looks up the size of, for
+ * the cases where that is a single layout.
+ */
+static PangoLayout *
+gtk_label_get_measuring_layout_for_size (GtkWidget      *widget,
+                                         GtkOrientation  orientation,
+                                         int             for_size)
+{
+  GtkLabel *self = GTK_LABEL (widget);
+
+  /* Subclasses may measure differently */
+  if (GTK_WIDGET_GET_CLASS (widget)->measure != gtk_label_measure)
+    return NULL;
+
+  if (!self->wrap && self->ellipsize == PANGO_ELLIPSIZE_NONE)
+    return gtk_label_get_measuring_layout (self, NULL, -1);
+
+  if (self->wrap && orientation == GTK_ORIENTATION_VERTICAL && for_size >= 0)
+    return gtk_label_get_measuring_layout (self, NULL, for_size * PANGO_SCALE);
+
+  return NULL;
+}
+
 void
 gtk_label_get_layout_location (GtkLabel  *self,
                                float     *xp,
@@ -2338,6 +2357,7 @@ gtk_label_class_init (GtkLabelClass *class)
   widget_class->focus = gtk_label_focus;
   widget_class->get_request_mode = gtk_label_get_request_mode;
   widget_class->measure = gtk_label_measure;
+  widget_class->priv->get_measuring_layout = gtk_label_get_measuring_layout_for_size;
   widget_class->direction_changed = gtk_label_direction_changed;
 
   class->move_cursor = gtk_label_move_cursor;
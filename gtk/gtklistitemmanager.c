@@ -26,6 +26,11 @@
 #include "gtksectionmodel.h"
 #include "gtkwidgetprivate.h"
 
+#include "gdk/gdkprofilerprivate.h"
+
+/* Number of unbound item widgets kept around for reuse */
+#define DEFAULT_MAX_SPARE_ITEMS 32
+
 typedef struct _GtkListItemChange GtkListItemChange;
 
 struct _GtkListItemManager
@@ -39,6 +44,13 @@ struct _GtkListItemManager
   GtkRbTree *items;
   GSList *trackers;
 
+  /* unparented and unbound item widgets, each holding a floating ref */
+  GQueue spare_items;
+  guint max_spare_items;
+
+  guint n_created_items;
+  guint n_recycled_items;
+
   GtkListTile * (* split_func) (GtkWidget *, GtkListTile *, guint);
   GtkListItemBase * (* create_widget) (GtkWidget *);
   void (* prepare_section) (GtkWidget *, GtkListTile *, guint);
@@ -67,6 +79,47 @@ struct _GtkListItemChange
 
 G_DEFINE_TYPE (GtkListItemManager, gtk_list_item_manager, G_TYPE_OBJECT)
 
+static guint created_items_counter;
+static guint recycled_items_counter;
+
+static void
+gtk_list_item_manager_release_item_widget (GtkListItemManager *self,
+                                           GtkListItemBase    *widget)
+{
+  if (g_queue_get_length (&self->spare_items) >= self->max_spare_items)
+    {
+      gtk_widget_unparent (GTK_WIDGET (widget));
+      return;
+    }
+
+  g_object_ref (widget);
+  gtk_list_item_base_update (widget, GTK_INVALID_LIST_POSITION, NULL, FALSE);
+  gtk_widget_unparent (GTK_WIDGET (widget));
+  /* Make it look like a freshly created widget to whoever parents it next */
+  g_object_force_floating (G_OBJECT (widget));
+
+  g_queue_push_tail (&self->spare_items, widget);
+}
+
+static GtkListItemBase *
+gtk_list_item_manager_acquire_item_widget (GtkListItemManager *self)
+{
+  GtkListItemBase *result;
+
+  result = g_queue_pop_head (&self->spare_items);
+  if (result)
+    {
+      self->n_recycled_items++;
+      gdk_profiler_set_int_counter (recycled_items_counter, self->n_recycled_items);
+      return result;
+    }
+
+  self->n_created_items++;
+  gdk_profiler_set_int_counter (created_items_counter, self->n_created_items);
+
+  return self->create_widget (self->widget);
+}
+
 static void
 gtk_list_item_change_init (GtkListItemChange *change)
 {
@@ -76,14 +129,27 @@ gtk_list_item_change_init (GtkListItemChange *change)
 }
 
 static void
-gtk_list_item_change_finish (GtkListItemChange *change)
+gtk_list_item_change_finish (GtkListItemManager *self,
+                             GtkListItemChange  *change)
 {
   GtkWidget *widget;
 
-  g_clear_pointer (&change->deleted_items, g_hash_table_destroy);
+  if (change->deleted_items)
+    {
+      GHashTableIter iter;
+      gpointer value;
+
+      g_hash_table_iter_init (&iter, change->deleted_items);
+      while (g_hash_table_iter_next (&iter, NULL, &value))
+        {
+          g_hash_table_iter_steal (&iter);
+          gtk_list_item_manager_release_item_widget (self, value);
+        }
+      g_clear_pointer (&change->deleted_items, g_hash_table_destroy);
+    }
 
   while ((widget = g_queue_pop_head (&change->recycled_items)))
-    gtk_widget_unparent (widget);
+    gtk_list_item_manager_release_item_widget (self, GTK_LIST_ITEM_BASE (widget));
   while ((widget = g_queue_pop_head (&change->recycled_headers)))
     gtk_widget_unparent (widget);
 }
@@ -120,6 +186,26 @@ gtk_list_item_change_release (GtkListItemChange *change,
     }
 }
 
+/* Makes all deleted widgets available for any item, not just
+ * for the item they were displaying.
+ */
+static void
+gtk_list_item_change_recycle_deleted (GtkListItemChange *change)
+{
+  GHashTableIter iter;
+  gpointer value;
+
+  if (change->deleted_items == NULL)
+    return;
+
+  g_hash_table_iter_init (&iter, change->deleted_items);
+  while (g_hash_table_iter_next (&iter, NULL, &value))
+    {
+      g_hash_table_iter_steal (&iter);
+      gtk_list_item_change_recycle (change, value);
+    }
+}
+
 static GtkListItemBase *
 gtk_list_item_change_find (GtkListItemChange *change,
                            gpointer           item)
@@ -1371,7 +1457,7 @@ gtk_list_item_manager_ensure_items (GtkListItemManager *self,
                   gpointer item = g_list_model_get_item (G_LIST_MODEL (self->model), position + i);
                   tile->widget = GTK_WIDGET (gtk_list_item_change_get (change, item));
                   if (tile->widget == NULL)
-                    tile->widget = GTK_WIDGET (self->create_widget (self->widget));
+                    tile->widget = GTK_WIDGET (gtk_list_item_manager_acquire_item_widget (self));
                   gtk_list_item_base_update (GTK_LIST_ITEM_BASE (tile->widget),
                                              position + i,
                                              item,
@@ -1611,7 +1697,7 @@ gtk_list_item_manager_model_items_changed_cb (GListModel         *model,
       tracker->widget = GTK_LIST_ITEM_BASE (tile->widget);
     }
 
-  gtk_list_item_change_finish (&change);
+  gtk_list_item_change_finish (self, &change);
 
   gtk_widget_queue_resize (self->widget);
 }
@@ -1691,7 +1777,7 @@ gtk_list_item_manager_model_sections_changed_cb (GListModel         *model,
 
   gtk_list_item_manager_ensure_items (self, &change, G_MAXUINT, 0);
 
-  gtk_list_item_change_finish (&change);
+  gtk_list_item_change_finish (self, &change);
 
   gtk_widget_queue_resize (GTK_WIDGET (self->widget));
 }
@@ -1733,17 +1819,15 @@ gtk_list_item_manager_model_selection_changed_cb (GListModel         *model,
 }
 
 static void
-gtk_list_item_manager_clear_model (GtkListItemManager *self)
+gtk_list_item_manager_clear_model (GtkListItemManager *self,
+                                   GtkListItemChange  *change)
 {
-  GtkListItemChange change;
   GSList *l;
 
   if (self->model == NULL)
     return;
 
-  gtk_list_item_change_init (&change);
-  gtk_list_item_manager_remove_items (self, &change, 0, g_list_model_get_n_items (G_LIST_MODEL (self->model)));
-  gtk_list_item_change_finish (&change);
+  gtk_list_item_manager_remove_items (self, change, 0, g_list_model_get_n_items (G_LIST_MODEL (self->model)));
   for (l = self->trackers; l; l = l->next)
     {
       gtk_list_item_tracker_unset_position (self, l->data);
@@ -1772,8 +1856,13 @@ static void
 gtk_list_item_manager_dispose (GObject *object)
 {
   GtkListItemManager *self = GTK_LIST_ITEM_MANAGER (object);
+  GtkListItemChange change;
 
-  gtk_list_item_manager_clear_model (self);
+  gtk_list_item_manager_set_max_spare_items (self, 0);
+
+  gtk_list_item_change_init (&change);
+  gtk_list_item_manager_clear_model (self, &change);
+  gtk_list_item_change_finish (self, &change);
 
   g_clear_pointer (&self->items, gtk_rb_tree_unref);
 
@@ -1786,29 +1875,42 @@ gtk_list_item_manager_class_init (GtkListItemManagerClass *klass)
   GObjectClass *object_class = G_OBJECT_CLASS (klass);
 
   object_class->dispose = gtk_list_item_manager_dispose;
+
+  if (created_items_counter == 0)
+    {
+      created_items_counter = gdk_profiler_define_int_counter ("list-items-created", "List item widgets created");
+      recycled_items_counter = gdk_profiler_define_int_counter ("list-items-recycled", "List item widgets reused");
+    }
 }
 
 static void
 gtk_list_item_manager_init (GtkListItemManager *self)
 {
+  g_queue_init (&self->spare_items);
+  self->max_spare_items = DEFAULT_MAX_SPARE_ITEMS;
 }
 
 void
 gtk_list_item_manager_set_model (GtkListItemManager *self,
                                  GtkSelectionModel  *model)
 {
+  GtkListItemChange change;
+
   g_return_if_fail (GTK_IS_LIST_ITEM_MANAGER (self));
   g_return_if_fail (model == NULL || GTK_IS_SELECTION_MODEL (model));
 
   if (self->model == model)
     return;
 
-  gtk_list_item_manager_clear_model (self);
+  /* Use a single change for removing the old items and adding the new
+   * ones, so that the widgets get rebound instead of recreated.
+   */
+  gtk_list_item_change_init (&change);
+  gtk_list_item_manager_clear_model (self, &change);
+  gtk_list_item_change_recycle_deleted (&change);
 
   if (model)
     {
-      GtkListItemChange change;
-
       self->model = g_object_ref (model);
 
       g_signal_connect (model,
@@ -1829,11 +1931,11 @@ gtk_list_item_manager_set_model (GtkListItemManager *self,
                           G_CALLBACK (gtk_list_item_manager_model_sections_changed_cb),
                           self);
 
-      gtk_list_item_change_init (&change);
       gtk_list_item_manager_add_items (self, &change, 0, g_list_model_get_n_items (G_LIST_MODEL (model)));
       gtk_list_item_manager_ensure_items (self, &change, G_MAXUINT, 0);
-      gtk_list_item_change_finish (&change);
     }
+
+  gtk_list_item_change_finish (self, &change);
 }
 
 GtkSelectionModel *
@@ -1901,7 +2003,7 @@ gtk_list_item_manager_set_has_sections (GtkListItemManager *self,
     }
 
   gtk_list_item_manager_ensure_items (self, &change, G_MAXUINT, 0);
-  gtk_list_item_change_finish (&change);
+  gtk_list_item_change_finish (self, &change);
 
   gtk_widget_queue_resize (self->widget);
 }
@@ -1912,6 +2014,66 @@ gtk_list_item_manager_get_has_sections (GtkListItemManager *self)
   return self->has_sections;
 }
 
+/*
+ * gtk_list_item_manager_clear_spare_items:
+ * @self: a `GtkListItemManager`
+ *
+ * Destroys all item widgets that are kept around for reuse.
+ *
+ * This needs to be called whenever the widget changes the setup of
+ * its item widgets, as the spare widgets are not part of any tile.
+ */
+void
+gtk_list_item_manager_clear_spare_items (GtkListItemManager *self)
+{
+  GtkListItemBase *widget;
+
+  while ((widget = g_queue_pop_head (&self->spare_items)))
+    {
+      g_object_ref_sink (widget);
+      g_object_unref (widget);
+    }
+}
+
+void
+gtk_list_item_manager_set_max_spare_items (GtkListItemManager *self,
+                                           guint               max_spare_items)
+{
+  GtkListItemBase *widget;
+
+  g_return_if_fail (GTK_IS_LIST_ITEM_MANAGER (self));
+
+  self->max_spare_items = max_spare_items;
+
+  while (g_queue_get_length (&self->spare_items) > max_spare_items)
+    {
+      widget = g_queue_pop_tail (&self->spare_items);
+      g_object_ref_sink (widget);
+      g_object_unref (widget);
+    }
+}
+
+guint
+gtk_list_item_manager_get_max_spare_items (GtkListItemManager *self)
+{
+  g_return_val_if_fail (GTK_IS_LIST_ITEM_MANAGER (self), 0);
+
+  return self->max_spare_items;
+}
+
+void
+gtk_list_item_manager_get_item_stats (GtkListItemManager *self,
+                                      guint              *n_created,
+                                      guint              *n_recycled)
+{
+  g_return_if_fail (GTK_IS_LIST_ITEM_MANAGER (self));
+
+  if (n_created)
+    *n_created = self->n_created_items;
+  if (n_recycled)
+    *n_recycled = self->n_recycled_items;
+}
+
 GtkListItemTracker *
 gtk_list_item_tracker_new (GtkListItemManager *self)
 {
@@ -1942,7 +2104,7 @@ gtk_list_item_tracker_free (GtkListItemManager *self,
 
   gtk_list_item_change_init (&change);
   gtk_list_item_manager_ensure_items (self, &change, G_MAXUINT, 0);
-  gtk_list_item_change_finish (&change);
+  gtk_list_item_change_finish (self, &change);
 
   gtk_widget_queue_resize (self->widget);
 }
@@ -1973,7 +2135,7 @@ gtk_list_item_tracker_set_position (GtkListItemManager *self,
 
   gtk_list_item_change_init (&change);
   gtk_list_item_manager_ensure_items (self, &change, G_MAXUINT, 0);
-  gtk_list_item_change_finish (&change);
+  gtk_list_item_change_finish (self, &change);
 
   tile = gtk_list_item_manager_get_nth (self, position, NULL);
   if (tile)
@@ -61,6 +61,9 @@ struct _GtkListTile
   guint n_items;
   /* area occupied by tile. May be empty if tile has no allocation */
   cairo_rectangle_int_t area;
+  /* set by the gridview if the area of a multirow tile was computed
+   * from estimated row heights */
+  guint estimated : 1;
 };
 
 struct _GtkListTileAugment
@@ -134,6 +137,15 @@ GtkSelectionModel *     gtk_list_item_manager_get_model         (GtkListItemMana
 void                    gtk_list_item_manager_set_has_sections  (GtkListItemManager     *self,
                                                                  gboolean                has_sections);
 gboolean                gtk_list_item_manager_get_has_sections  (GtkListItemManager     *self);
+void                    gtk_list_item_manager_clear_spare_items (GtkListItemManager     *self);
+void                    gtk_list_item_manager_set_max_spare_items
+                                                                (GtkListItemManager     *self,
+                                                                 guint                   max_spare_items);
+guint                   gtk_list_item_manager_get_max_spare_items
+                                                                (GtkListItemManager     *self);
+void                    gtk_list_item_manager_get_item_stats    (GtkListItemManager     *self,
+                                                                 guint                  *n_created,
+                                                                 guint                  *n_recycled);
 
 GtkListItemTracker *    gtk_list_item_tracker_new               (GtkListItemManager     *self);
 void                    gtk_list_item_tracker_free              (GtkListItemManager     *self,
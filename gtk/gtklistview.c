@@ -152,6 +152,7 @@ enum
 {
   PROP_0,
   PROP_ENABLE_RUBBERBAND,
+  PROP_ESTIMATED_ROW_HEIGHT,
   PROP_FACTORY,
   PROP_HEADER_FACTORY,
   PROP_MODEL,
@@ -225,6 +226,8 @@ gtk_list_view_update_factories_with (GtkListView        *self,
 {
   GtkListTile *tile;
 
+  gtk_list_item_manager_clear_spare_items (self->item_manager);
+
   for (tile = gtk_list_item_manager_get_first (self->item_manager);
        tile != NULL;
        tile = gtk_rb_tree_node_get_next (tile))
@@ -476,6 +479,9 @@ static guint
 gtk_list_view_get_unknown_row_height (GtkListView *self,
                                       GArray      *heights)
 {
+  if (self->estimated_row_height >= 0)
+    return self->estimated_row_height;
+
   g_return_val_if_fail (heights->len > 0, 0);
 
   /* return the median and hope rows are generally uniform with few outliers */
@@ -484,6 +490,52 @@ gtk_list_view_get_unknown_row_height (GtkListView *self,
   return g_array_index (heights, int, heights->len / 2);
 }
 
+/* Only move the height used for rows without widgets towards the
+ * median of the measured rows in small steps, so that the scrollbar
+ * doesn't jump around while rows of varying heights scroll into view.
+ */
+#define UNKNOWN_ROW_HEIGHT_DAMPING 8
+
+static guint
+gtk_list_view_update_unknown_row_height (GtkListView *self,
+                                         GArray      *heights)
+{
+  guint n_created, n_recycled;
+  int median, step;
+
+  if (self->estimated_row_height >= 0)
+    return self->estimated_row_height;
+
+  if (heights->len == 0)
+    return MAX (self->unknown_row_height, 0);
+
+  /* Only change the estimate when new rows have been measured. The
+   * list base keeps the anchor in place when rows above it change
+   * their height, so the visible rows don't move when it does.
+   */
+  gtk_list_item_manager_get_item_stats (self->item_manager, &n_created, &n_recycled);
+  if (self->unknown_row_height >= 0 &&
+      self->n_estimated_items == n_created + n_recycled)
+    return self->unknown_row_height;
+
+  self->n_estimated_items = n_created + n_recycled;
+
+  median = gtk_list_view_get_unknown_row_height (self, heights);
+  if (self->unknown_row_height < 0)
+    {
+      self->unknown_row_height = median;
+    }
+  else
+    {
+      step = (median - self->unknown_row_height) / UNKNOWN_ROW_HEIGHT_DAMPING;
+      if (step == 0 && median != self->unknown_row_height)
+        step = median > self->unknown_row_height ? 1 : -1;
+      self->unknown_row_height += step;
+    }
+
+  return self->unknown_row_height;
+}
+
 static void
 gtk_list_view_measure_across (GtkWidget      *widget,
                               GtkOrientation  orientation,
@@ -567,7 +619,18 @@ gtk_list_view_measure_list (GtkWidget      *widget,
         }
     }
 
-  if (n_unknown)
+  /* Use the same estimate as size_allocate once it has one, so
+   * that our size matches the list we allocate.
+   */
+  if (n_unknown && (self->estimated_row_height >= 0 || self->unknown_row_height >= 0))
+    {
+      int row_height = self->estimated_row_height >= 0 ? self->estimated_row_height
+                                                       : self->unknown_row_height;
+
+      min += n_unknown * row_height;
+      nat += n_unknown * row_height;
+    }
+  else if (n_unknown)
     {
       min += n_unknown * gtk_list_view_get_unknown_row_height (self, min_heights);
       nat += n_unknown * gtk_list_view_get_unknown_row_height (self, nat_heights);
@@ -658,7 +721,7 @@ gtk_list_view_size_allocate (GtkWidget *widget,
     }
 
   /* step 3: determine height of unknown items and set the positions */
-  row_height = gtk_list_view_get_unknown_row_height (self, heights);
+  row_height = gtk_list_view_update_unknown_row_height (self, heights);
   g_array_free (heights, TRUE);
 
   y = 0;
@@ -754,6 +817,10 @@ gtk_list_view_get_property (GObject    *object,
       g_value_set_boolean (value, gtk_list_base_get_enable_rubberband (GTK_LIST_BASE (self)));
       break;
 
+    case PROP_ESTIMATED_ROW_HEIGHT:
+      g_value_set_int (value, self->estimated_row_height);
+      break;
+
     case PROP_FACTORY:
       g_value_set_object (value, self->factory);
       break;
@@ -798,6 +865,10 @@ gtk_list_view_set_property (GObject      *object,
       gtk_list_view_set_enable_rubberband (self, g_value_get_boolean (value));
       break;
 
+    case PROP_ESTIMATED_ROW_HEIGHT:
+      gtk_list_view_set_estimated_row_height (self, g_value_get_int (value));
+      break;
+
     case PROP_FACTORY:
       gtk_list_view_set_factory (self, g_value_get_object (value));
       break;
@@ -884,6 +955,21 @@ gtk_list_view_class_init (GtkListViewClass *klass)
                           FALSE,
                           G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY);
 
+  /**
+   * GtkListView:estimated-row-height:
+   *
+   * The height to assume for rows that have not been measured.
+   *
+   * If this is -1, the listview guesses the height from the rows
+   * it has measured.
+   *
+   * Since: 4.22
+   */
+  properties[PROP_ESTIMATED_ROW_HEIGHT] =
+    g_param_spec_int ("estimated-row-height", NULL, NULL,
+                      -1, G_MAXINT, -1,
+                      G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY | G_PARAM_STATIC_STRINGS);
+
   /**
    * GtkListView:factory:
    *
@@ -1002,6 +1088,8 @@ static void
 gtk_list_view_init (GtkListView *self)
 {
   self->item_manager = gtk_list_base_get_manager (GTK_LIST_BASE (self));
+  self->estimated_row_height = -1;
+  self->unknown_row_height = -1;
 
   gtk_list_base_set_anchor_max_widgets (GTK_LIST_BASE (self),
                                         GTK_LIST_VIEW_MAX_LIST_ITEMS,
@@ -1083,6 +1171,8 @@ gtk_list_view_set_model (GtkListView       *self,
   if (!gtk_list_base_set_model (GTK_LIST_BASE (self), model))
     return;
 
+  self->unknown_row_height = -1;
+
   gtk_accessible_update_property (GTK_ACCESSIBLE (self),
                                   GTK_ACCESSIBLE_PROPERTY_MULTI_SELECTABLE, GTK_IS_MULTI_SELECTION (model),
                                   -1);
@@ -1257,6 +1347,8 @@ gtk_list_view_set_single_click_activate (GtkListView *self,
 
   self->single_click_activate = single_click_activate;
 
+  gtk_list_item_manager_clear_spare_items (self->item_manager);
+
   for (tile = gtk_list_item_manager_get_first (self->item_manager);
        tile != NULL;
        tile = gtk_rb_tree_node_get_next (tile))
@@ -1322,6 +1414,60 @@ gtk_list_view_get_enable_rubberband (GtkListView *self)
   return gtk_list_base_get_enable_rubberband (GTK_LIST_BASE (self));
 }
 
+/**
+ * gtk_list_view_set_estimated_row_height:
+ * @self: a listview
+ * @height: the height to assume for rows that have not been measured,
+ *   or -1 to guess it
+ *
+ * Sets the height the listview assumes for rows it has not created
+ * widgets for.
+ *
+ * The listview only measures the rows that are close to the visible
+ * area. The size of all the other rows is guessed from the rows it has
+ * measured, which can make the scrollbar change size while scrolling
+ * through lists with rows of varying heights.
+ *
+ * If the application knows a good estimate for the row height, it can
+ * set it here to keep the scrollbar stable.
+ *
+ * Since: 4.22
+ */
+void
+gtk_list_view_set_estimated_row_height (GtkListView *self,
+                                        int          height)
+{
+  g_return_if_fail (GTK_IS_LIST_VIEW (self));
+  g_return_if_fail (height >= -1);
+
+  if (self->estimated_row_height == height)
+    return;
+
+  self->estimated_row_height = height;
+
+  gtk_widget_queue_resize (GTK_WIDGET (self));
+
+  g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_ESTIMATED_ROW_HEIGHT]);
+}
+
+/**
+ * gtk_list_view_get_estimated_row_height:
+ * @self: a listview
+ *
+ * Gets the height assumed for rows that have not been measured.
+ *
+ * Returns: the estimated row height or -1 if it is guessed
+ *
+ * Since: 4.22
+ */
+int
+gtk_list_view_get_estimated_row_height (GtkListView *self)
+{
+  g_return_val_if_fail (GTK_IS_LIST_VIEW (self), -1);
+
+  return self->estimated_row_height;
+}
+
 /**
  * gtk_list_view_set_tab_behavior:
  * @self: a listview
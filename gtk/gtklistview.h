@@ -89,6 +89,12 @@ GDK_AVAILABLE_IN_4_12
 GtkListTabBehavior
                 gtk_list_view_get_tab_behavior                  (GtkListView            *self);
 
+GDK_AVAILABLE_IN_4_22
+void            gtk_list_view_set_estimated_row_height          (GtkListView            *self,
+                                                                 int                     height);
+GDK_AVAILABLE_IN_4_22
+int             gtk_list_view_get_estimated_row_height          (GtkListView            *self);
+
 GDK_AVAILABLE_IN_4_12
 void            gtk_list_view_scroll_to                         (GtkListView            *self,
                                                                  guint                   pos,
@@ -33,6 +33,10 @@ struct _GtkListView
   GtkListItemFactory *header_factory;
   gboolean show_separators;
   gboolean single_click_activate;
+  int estimated_row_height;
+  int unknown_row_height;
+  /* number of item widgets handed out when unknown_row_height was updated */
+  guint n_estimated_items;
 };
 
 struct _GtkListViewClass
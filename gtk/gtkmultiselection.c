@@ -130,46 +130,68 @@ gtk_multi_selection_get_selection_in_range (GtkSelectionModel *model,
   return gtk_bitset_ref (self->selected);
 }
 
+static gboolean
+is_unselected_item (gpointer key,
+                    gpointer value,
+                    gpointer unselected)
+{
+  return gtk_bitset_contains (unselected, GPOINTER_TO_UINT (value));
+}
+
 static void
 gtk_multi_selection_toggle_selection (GtkMultiSelection *self,
                                       GtkBitset         *changes)
 {
   GListModel *model = G_LIST_MODEL (self);
-  GtkBitsetIter change_iter, selected_iter;
-  GtkBitset *selected;
-  guint change_pos, selected_pos;
+  GtkBitsetIter iter;
+  GtkBitset *selected, *unselected;
+  guint64 n_unselected;
+  guint pos;
   gboolean more;
 
   gtk_bitset_difference (self->selected, changes);
 
   selected = gtk_bitset_copy (changes);
   gtk_bitset_intersect (selected, self->selected);
+  unselected = gtk_bitset_copy (changes);
+  gtk_bitset_subtract (unselected, selected);
 
-  if (!gtk_bitset_iter_init_first (&selected_iter, selected, &selected_pos))
-    selected_pos = G_MAXUINT;
-
-  for (more = gtk_bitset_iter_init_first (&change_iter, changes, &change_pos);
-       more;
-       more = gtk_bitset_iter_next (&change_iter, &change_pos))
+  /* For large unselections, drop the items by their position instead
+   * of looking each of them up in the model. This avoids creating
+   * items for models that generate them on demand.
+   */
+  n_unselected = gtk_bitset_get_size (unselected);
+  if (gtk_bitset_is_empty (self->selected))
     {
-      gpointer item = g_list_model_get_item (model, change_pos);
-
-      if (change_pos < selected_pos)
+      g_hash_table_remove_all (self->items);
+    }
+  else if (n_unselected > g_hash_table_size (self->items) / 4)
+    {
+      g_hash_table_foreach_remove (self->items, is_unselected_item, unselected);
+    }
+  else
+    {
+      for (more = gtk_bitset_iter_init_first (&iter, unselected, &pos);
+           more;
+           more = gtk_bitset_iter_next (&iter, &pos))
         {
+          gpointer item = g_list_model_get_item (model, pos);
+
           g_hash_table_remove (self->items, item);
           g_object_unref (item);
         }
-      else
-        {
-          g_assert (change_pos == selected_pos);
+    }
 
-          g_hash_table_insert (self->items, item, GUINT_TO_POINTER (change_pos));
+  for (more = gtk_bitset_iter_init_first (&iter, selected, &pos);
+       more;
+       more = gtk_bitset_iter_next (&iter, &pos))
+    {
+      gpointer item = g_list_model_get_item (model, pos);
 
-          if (!gtk_bitset_iter_next (&selected_iter, &selected_pos))
-            selected_pos = G_MAXUINT;
-        }
+      g_hash_table_insert (self->items, item, GUINT_TO_POINTER (pos));
     }
 
+  gtk_bitset_unref (unselected);
   gtk_bitset_unref (selected);
 }
 
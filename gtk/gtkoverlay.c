@@ -217,13 +217,21 @@ gtk_overlay_snapshot_child (GtkWidget   *overlay,
   gtk_snapshot_pop (snapshot);
 }
 
+/* The opaque area of clipped overlays is only known after clipping */
+static gboolean
+gtk_overlay_child_can_cover (GtkWidget *widget,
+                             GtkWidget *child)
+{
+  return !gtk_overlay_get_clip_overlay (GTK_OVERLAY (widget), child);
+}
+
 static void
 gtk_overlay_snapshot (GtkWidget   *widget,
                       GtkSnapshot *snapshot)
 {
   GtkWidget *child;
 
-  for (child = _gtk_widget_get_first_child (widget);
+  for (child = gtk_widget_get_first_unoccluded_child (widget, gtk_overlay_child_can_cover);
        child != NULL;
        child = _gtk_widget_get_next_sibling (child))
     {
@@ -26,6 +26,13 @@
 #include "gtkpangoprivate.h"
 #include <pango/pangocairo.h>
 #include "gtkbuilderprivate.h"
+#include "gdk/gdkprofilerprivate.h"
+
+#if defined(GDK_WINDOWING_X11) || defined(GDK_WINDOWING_WAYLAND)
+#include <pango/pangofc-fontmap.h>
+#endif
+
+#include <string.h>
 
 static gboolean
 attr_list_merge_filter (PangoAttribute *attribute,
@@ -1291,3 +1298,548 @@ gtk_pango_layout_has_color_glyphs (PangoLayout *layout)
   return ret;
 }
 
+
+/* A process-wide cache for the sizes of laid out text.
+ *
+ * Widgets in list views get rebound to the same short strings over
+ * and over, and every time they are measured the text is shaped again
+ * just to find its size. The cache is keyed by everything that can
+ * influence the size of a layout, so measuring identical text can skip
+ * shaping altogether.
+ */
+
+#define SIZE_CACHE_MAX_ENTRIES 2048
+#define SIZE_CACHE_MAX_TEXT    (256 * 1024)
+
+typedef struct
+{
+  GList link;
+  guint hash;
+
+  char *text;
+  PangoAttrList *attrs;
+  PangoFontDescription *font_desc;
+  PangoFontMap *font_map;
+  guint font_map_serial;
+  PangoFontDescription *context_font_desc;
+  cairo_font_options_t *font_options;
+  PangoLanguage *language;
+  double resolution;
+  PangoDirection base_dir;
+  PangoGravity base_gravity;
+  PangoGravityHint gravity_hint;
+  int width;
+  int height;
+  int indent;
+  int spacing;
+  float line_spacing;
+  PangoWrapMode wrap;
+  PangoEllipsizeMode ellipsize;
+  PangoAlignment alignment;
+  guint justify : 1;
+  guint auto_dir : 1;
+  guint single_paragraph : 1;
+  guint round_glyph_positions : 1;
+
+  int result_width;
+  int result_height;
+  int result_baseline;
+} SizeCacheEntry;
+
+static GHashTable *size_cache;
+static GQueue size_cache_lru;
+static gsize size_cache_text;
+static guint size_cache_hits_counter;
+static guint size_cache_misses_counter;
+static guint64 size_cache_hits;
+static guint64 size_cache_misses;
+
+static guint
+size_cache_entry_hash (gconstpointer data)
+{
+  const SizeCacheEntry *entry = data;
+
+  return entry->hash;
+}
+
+static gboolean
+size_cache_entry_equal (gconstpointer a,
+                        gconstpointer b)
+{
+  const SizeCacheEntry *e1 = a;
+  const SizeCacheEntry *e2 = b;
+
+  if (e1->hash != e2->hash ||
+      e1->width != e2->width ||
+      e1->height != e2->height ||
+      e1->indent != e2->indent ||
+      e1->spacing != e2->spacing ||
+      e1->line_spacing != e2->line_spacing ||
+      e1->wrap != e2->wrap ||
+      e1->ellipsize != e2->ellipsize ||
+      e1->alignment != e2->alignment ||
+      e1->justify != e2->justify ||
+      e1->auto_dir != e2->auto_dir ||
+      e1->single_paragraph != e2->single_paragraph ||
+      e1->round_glyph_positions != e2->round_glyph_positions ||
+      e1->font_map != e2->font_map ||
+      e1->font_map_serial != e2->font_map_serial ||
+      e1->language != e2->language ||
+      e1->resolution != e2->resolution ||
+      e1->base_dir != e2->base_dir ||
+      e1->base_gravity != e2->base_gravity ||
+      e1->gravity_hint != e2->gravity_hint)
+    return FALSE;
+
+  if (strcmp (e1->text, e2->text) != 0)
+    return FALSE;
+
+  if ((e1->font_desc == NULL) != (e2->font_desc == NULL) ||
+      (e1->font_desc && !pango_font_description_equal (e1->font_desc, e2->font_desc)))
+    return FALSE;
+
+  if (!pango_font_description_equal (e1->context_font_desc, e2->context_font_desc))
+    return FALSE;
+
+  if ((e1->font_options == NULL) != (e2->font_options == NULL) ||
+      (e1->font_options && !cairo_font_options_equal (e1->font_options, e2->font_options)))
+    return FALSE;
+
+  if ((e1->attrs == NULL) != (e2->attrs == NULL) ||
+      (e1->attrs && !pango_attr_list_equal (e1->attrs, e2->attrs)))
+    return FALSE;
+
+  return TRUE;
+}
+
+static void
+size_cache_entry_free_unlinked (SizeCacheEntry *entry)
+{
+  g_free (entry->text);
+  g_clear_pointer (&entry->attrs, pango_attr_list_unref);
+  g_clear_pointer (&entry->font_desc, pango_font_description_free);
+  g_clear_object (&entry->font_map);
+  g_clear_pointer (&entry->context_font_desc, pango_font_description_free);
+  g_clear_pointer (&entry->font_options, cairo_font_options_destroy);
+  g_free (entry);
+}
+
+static void
+size_cache_entry_free (gpointer data)
+{
+  SizeCacheEntry *entry = data;
+
+  size_cache_text -= strlen (entry->text);
+  g_queue_unlink (&size_cache_lru, &entry->link);
+
+  size_cache_entry_free_unlinked (entry);
+}
+
+/* Fills in the key fields of @entry without taking references.
+ * Returns FALSE if the layout has properties that we don't track,
+ * in which case its size is not cached.
+ */
+static gboolean
+size_cache_entry_init (SizeCacheEntry *entry,
+                       PangoLayout    *layout)
+{
+  PangoContext *context;
+  PangoTabArray *tabs;
+
+  context = pango_layout_get_context (layout);
+
+  if (pango_context_get_matrix (context) != NULL ||
+      pango_context_get_font_description (context) == NULL)
+    return FALSE;
+
+  tabs = pango_layout_get_tabs (layout);
+  if (tabs != NULL)
+    {
+      pango_tab_array_free (tabs);
+      return FALSE;
+    }
+
+  entry->text = (char *) pango_layout_get_text (layout);
+  entry->attrs = pango_layout_get_attributes (layout);
+  entry->font_desc = (PangoFontDescription *) pango_layout_get_font_description (layout);
+  entry->font_map = pango_context_get_font_map (context);
+  entry->font_map_serial = pango_font_map_get_serial (entry->font_map);
+  entry->context_font_desc = pango_context_get_font_description (context);
+  entry->font_options = (cairo_font_options_t *) pango_cairo_context_get_font_options (context);
+  entry->language = pango_context_get_language (context);
+  entry->resolution = pango_cairo_context_get_resolution (context);
+  entry->base_dir = pango_context_get_base_dir (context);
+  entry->base_gravity = pango_context_get_base_gravity (context);
+  entry->gravity_hint = pango_context_get_gravity_hint (context);
+  entry->round_glyph_positions = pango_context_get_round_glyph_positions (context);
+  entry->width = pango_layout_get_width (layout);
+  entry->height = pango_layout_get_height (layout);
+  entry->indent = pango_layout_get_indent (layout);
+  entry->spacing = pango_layout_get_spacing (layout);
+  entry->line_spacing = pango_layout_get_line_spacing (layout);
+  entry->wrap = pango_layout_get_wrap (layout);
+  entry->ellipsize = pango_layout_get_ellipsize (layout);
+  entry->alignment = pango_layout_get_alignment (layout);
+  entry->justify = pango_layout_get_justify (layout);
+  entry->auto_dir = pango_layout_get_auto_dir (layout);
+  entry->single_paragraph = pango_layout_get_single_paragraph_mode (layout);
+
+  entry->hash = g_str_hash (entry->text) ^
+                (guint) entry->width * 31 ^
+                pango_font_description_hash (entry->context_font_desc);
+
+  return TRUE;
+}
+
+static void
+ensure_size_cache (void)
+{
+  if (G_LIKELY (size_cache != NULL))
+    return;
+
+  size_cache = g_hash_table_new_full (size_cache_entry_hash,
+                                      size_cache_entry_equal,
+                                      NULL,
+                                      size_cache_entry_free);
+  size_cache_hits_counter = gdk_profiler_define_int_counter ("pango-size-cache-hits",
+                                                             "Text sizes found in the cache");
+  size_cache_misses_counter = gdk_profiler_define_int_counter ("pango-size-cache-misses",
+                                                               "Text sizes not found in the cache");
+}
+
+/* Returns a copy of @key that owns its fields */
+static SizeCacheEntry *
+size_cache_entry_copy (const SizeCacheEntry *key)
+{
+  SizeCacheEntry *entry;
+
+  entry = g_memdup2 (key, sizeof (SizeCacheEntry));
+  entry->link.data = entry;
+  entry->text = g_strdup (key->text);
+  entry->attrs = key->attrs ? pango_attr_list_copy (key->attrs) : NULL;
+  entry->font_desc = key->font_desc ? pango_font_description_copy (key->font_desc) : NULL;
+  entry->font_map = g_object_ref (key->font_map);
+  entry->context_font_desc = pango_font_description_copy (key->context_font_desc);
+  entry->font_options = key->font_options ? cairo_font_options_copy (key->font_options) : NULL;
+
+  return entry;
+}
+
+static void
+size_cache_insert (SizeCacheEntry *entry)
+{
+  g_queue_push_head_link (&size_cache_lru, &entry->link);
+  size_cache_text += strlen (entry->text);
+  g_hash_table_add (size_cache, entry);
+
+  while (size_cache_lru.length > SIZE_CACHE_MAX_ENTRIES ||
+         (size_cache_text > SIZE_CACHE_MAX_TEXT && size_cache_lru.length > 1))
+    g_hash_table_remove (size_cache, g_queue_peek_tail (&size_cache_lru));
+}
+
+/*
+ * gtk_pango_layout_get_cached_size:
+ * @layout: a `PangoLayout`
+ * @width: (out) (optional): return location for the logical width
+ * @height: (out) (optional): return location for the logical height
+ * @baseline: (out) (optional): return location for the baseline
+ *
+ * Gets the same values as pango_layout_get_size() and
+ * pango_layout_get_baseline(), but looks them up in a process-wide
+ * cache first, so that measuring the same text again does not need
+ * to shape it.
+ *
+ * The cache is only valid for layouts that have not been modified
+ * after their properties were set, which is true for layouts used
+ * for measuring.
+ */
+void
+gtk_pango_layout_get_cached_size (PangoLayout *layout,
+                                  int         *width,
+                                  int         *height,
+                                  int         *baseline)
+{
+  SizeCacheEntry key = { { NULL, }, };
+  SizeCacheEntry *entry;
+  int w, h, b;
+
+  if (!size_cache_entry_init (&key, layout))
+    {
+      pango_layout_get_size (layout, width, height);
+      if (baseline)
+        *baseline = pango_layout_get_baseline (layout);
+      return;
+    }
+
+  ensure_size_cache ();
+
+  entry = g_hash_table_lookup (size_cache, &key);
+  if (entry)
+    {
+      size_cache_hits++;
+      gdk_profiler_set_int_counter (size_cache_hits_counter, size_cache_hits);
+
+      g_queue_unlink (&size_cache_lru, &entry->link);
+      g_queue_push_head_link (&size_cache_lru, &entry->link);
+
+      w = entry->result_width;
+      h = entry->result_height;
+      b = entry->result_baseline;
+    }
+  else
+    {
+      size_cache_misses++;
+      gdk_profiler_set_int_counter (size_cache_misses_counter, size_cache_misses);
+
+      pango_layout_get_size (layout, &w, &h);
+      b = pango_layout_get_baseline (layout);
+
+      entry = size_cache_entry_copy (&key);
+      entry->result_width = w;
+      entry->result_height = h;
+      entry->result_baseline = b;
+
+      size_cache_insert (entry);
+    }
+
+  if (width)
+    *width = w;
+  if (height)
+    *height = h;
+  if (baseline)
+    *baseline = b;
+}
+
+/* Measuring text on worker threads.
+ *
+ * Pango font maps are not thread-safe, but every thread gets its own
+ * default font map, loaded from the same fontconfig configuration.
+ * So text using the default font map can be laid out on a worker
+ * thread with a private context that replicates the one of the
+ * layout, and will have the same size. The results go into the
+ * size cache, where the main thread finds them when it measures.
+ */
+
+#define PREFETCH_MIN_TEXT   4096 /* bytes of text worth handing to threads */
+#define PREFETCH_MAX_THREADS   4
+
+typedef struct
+{
+  GPtrArray *entries;
+  int next_entry;
+  int n_running;
+  GMutex mutex;
+  GCond cond;
+} PrefetchBatch;
+
+static GThreadPool *prefetch_pool;
+
+static void
+prefetch_entry_measure (SizeCacheEntry *entry)
+{
+  PangoContext *context;
+  PangoLayout *layout;
+
+  context = pango_font_map_create_context (pango_cairo_font_map_get_default ());
+  pango_context_set_font_description (context, entry->context_font_desc);
+  pango_context_set_language (context, entry->language);
+  pango_context_set_base_dir (context, entry->base_dir);
+  pango_context_set_base_gravity (context, entry->base_gravity);
+  pango_context_set_gravity_hint (context, entry->gravity_hint);
+  pango_context_set_round_glyph_positions (context, entry->round_glyph_positions);
+  pango_cairo_context_set_font_options (context, entry->font_options);
+  pango_cairo_context_set_resolution (context, entry->resolution);
+
+  layout = pango_layout_new (context);
+  pango_layout_set_auto_dir (layout, entry->auto_dir);
+  pango_layout_set_text (layout, entry->text, -1);
+  pango_layout_set_attributes (layout, entry->attrs);
+  pango_layout_set_font_description (layout, entry->font_desc);
+  pango_layout_set_width (layout, entry->width);
+  pango_layout_set_height (layout, entry->height);
+  pango_layout_set_indent (layout, entry->indent);
+  pango_layout_set_spacing (layout, entry->spacing);
+  pango_layout_set_line_spacing (layout, entry->line_spacing);
+  pango_layout_set_wrap (layout, entry->wrap);
+  pango_layout_set_ellipsize (layout, entry->ellipsize);
+  pango_layout_set_alignment (layout, entry->alignment);
+  pango_layout_set_justify (layout, entry->justify);
+  pango_layout_set_single_paragraph_mode (layout, entry->single_paragraph);
+
+  pango_layout_get_size (layout, &entry->result_width, &entry->result_height);
+  entry->result_baseline = pango_layout_get_baseline (layout);
+
+  g_object_unref (layout);
+  g_object_unref (context);
+}
+
+static void
+prefetch_batch_run (PrefetchBatch *batch)
+{
+  while (TRUE)
+    {
+      int i = g_atomic_int_add (&batch->next_entry, 1);
+
+      if (i >= (int) batch->entries->len)
+        break;
+
+      prefetch_entry_measure (g_ptr_array_index (batch->entries, i));
+    }
+}
+
+/* Workers use their own default font map, which is created with
+ * default settings from the current fontconfig configuration. That
+ * only gives the same sizes as long as the default font map of the
+ * main thread hasn't been replaced or configured differently.
+ */
+static gboolean
+prefetch_font_map_is_pristine (PangoFontMap *font_map)
+{
+  static GType pristine_type = G_TYPE_INVALID;
+
+  if (pristine_type == G_TYPE_INVALID)
+    {
+      PangoFontMap *fresh = pango_cairo_font_map_new ();
+
+      pristine_type = G_OBJECT_TYPE (fresh);
+      g_object_unref (fresh);
+    }
+
+  /* pango_cairo_font_map_set_default() with some other kind of map */
+  if (G_OBJECT_TYPE (font_map) != pristine_type)
+    return FALSE;
+
+  if (pango_cairo_font_map_get_resolution (PANGO_CAIRO_FONT_MAP (font_map)) != 96.0)
+    return FALSE;
+
+#if defined(GDK_WINDOWING_X11) || defined(GDK_WINDOWING_WAYLAND)
+  /* pango_fc_font_map_set_config(), for example to add application fonts */
+  if (PANGO_IS_FC_FONT_MAP (font_map))
+    {
+      FcConfig *config = pango_fc_font_map_get_config (PANGO_FC_FONT_MAP (font_map));
+
+      if (config != NULL && config != FcConfigGetCurrent ())
+        return FALSE;
+    }
+#endif
+
+  return TRUE;
+}
+
+static void
+prefetch_thread_func (gpointer data,
+                      gpointer user_data)
+{
+  PrefetchBatch *batch = data;
+
+  prefetch_batch_run (batch);
+
+  g_mutex_lock (&batch->mutex);
+  batch->n_running--;
+  g_cond_signal (&batch->cond);
+  g_mutex_unlock (&batch->mutex);
+}
+
+/*
+ * gtk_pango_layout_prefetch_sizes:
+ * @layouts: (array length=n_layouts): layouts that are about to be measured
+ * @n_layouts: the number of layouts
+ *
+ * Lays out the text of @layouts on worker threads and puts the
+ * results into the cache used by gtk_pango_layout_get_cached_size().
+ *
+ * Layouts whose size is already cached, that can't be cached, or
+ * that don't use the default font map are skipped. Nothing is done
+ * if the default font map has been replaced or reconfigured, as the
+ * workers could not reproduce it. If there is not
+ * enough text to make it worthwhile, nothing is done and the layouts
+ * get measured on the main thread as usual.
+ */
+void
+gtk_pango_layout_prefetch_sizes (PangoLayout **layouts,
+                                 guint         n_layouts)
+{
+  PrefetchBatch batch = { NULL, };
+  PangoFontMap *default_font_map;
+  gsize n_bytes = 0;
+  guint i, n_threads;
+  gint64 before G_GNUC_UNUSED;
+
+  if (n_layouts < 2)
+    return;
+
+  if (prefetch_pool == NULL)
+    {
+      n_threads = CLAMP (g_get_num_processors () - 1, 0, PREFETCH_MAX_THREADS);
+      if (n_threads == 0)
+        return;
+
+      prefetch_pool = g_thread_pool_new (prefetch_thread_func, NULL, n_threads, FALSE, NULL);
+    }
+
+  before = GDK_PROFILER_CURRENT_TIME;
+
+  default_font_map = pango_cairo_font_map_get_default ();
+  if (!prefetch_font_map_is_pristine (default_font_map))
+    return;
+
+  ensure_size_cache ();
+  batch.entries = g_ptr_array_new ();
+
+  for (i = 0; i < n_layouts; i++)
+    {
+      SizeCacheEntry key = { { NULL, }, };
+      guint j;
+
+      if (!size_cache_entry_init (&key, layouts[i]) ||
+          key.font_map != default_font_map ||
+          g_hash_table_contains (size_cache, &key))
+        continue;
+
+      for (j = 0; j < batch.entries->len; j++)
+        {
+          if (size_cache_entry_equal (&key, g_ptr_array_index (batch.entries, j)))
+            break;
+        }
+      if (j < batch.entries->len)
+        continue;
+
+      g_ptr_array_add (batch.entries, size_cache_entry_copy (&key));
+      n_bytes += strlen (key.text);
+    }
+
+  if (batch.entries->len >= 2 && n_bytes >= PREFETCH_MIN_TEXT)
+    {
+      g_mutex_init (&batch.mutex);
+      g_cond_init (&batch.cond);
+
+      n_threads = MIN (g_thread_pool_get_max_threads (prefetch_pool), batch.entries->len - 1);
+      batch.n_running = n_threads;
+      for (i = 0; i < n_threads; i++)
+        g_thread_pool_push (prefetch_pool, &batch, NULL);
+
+      /* The main thread takes its share of the work too */
+      prefetch_batch_run (&batch);
+
+      g_mutex_lock (&batch.mutex);
+      while (batch.n_running > 0)
+        g_cond_wait (&batch.cond, &batch.mutex);
+      g_mutex_unlock (&batch.mutex);
+
+      g_mutex_clear (&batch.mutex);
+      g_cond_clear (&batch.cond);
+
+      for (i = 0; i < batch.entries->len; i++)
+        size_cache_insert (g_ptr_array_index (batch.entries, i));
+
+      gdk_profiler_end_markf (before, "Prefetch text sizes", "%u layouts, %" G_GSIZE_FORMAT " bytes",
+                              batch.entries->len, n_bytes);
+    }
+  else
+    {
+      for (i = 0; i < batch.entries->len; i++)
+        size_cache_entry_free_unlinked (g_ptr_array_index (batch.entries, i));
+    }
+
+  g_ptr_array_unref (batch.entries);
+}
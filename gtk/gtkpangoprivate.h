@@ -85,4 +85,11 @@ char *gtk_pango_get_string_at   (PangoLayout                  *layout,
 gboolean gtk_pango_glyph_item_has_color_glyphs (PangoGlyphItem *item);
 gboolean gtk_pango_layout_has_color_glyphs     (PangoLayout    *layout);
 
+void gtk_pango_layout_get_cached_size (PangoLayout *layout,
+                                       int         *width,
+                                       int         *height,
+                                       int         *baseline);
+void gtk_pango_layout_prefetch_sizes  (PangoLayout **layouts,
+                                       guint         n_layouts);
+
 G_END_DECLS
@@ -148,7 +148,32 @@ gtk_selection_filter_model_selection_changed_cb (GListModel              *model,
                                                  guint                    n_items,
                                                  GtkSelectionFilterModel *self)
 {
-  selection_filter_model_items_changed (self, position, n_items, n_items);
+  GtkBitset *selection, *changes;
+  guint first, last;
+
+  if (n_items == 0)
+    return;
+
+  /* Selection models are free to report a larger range than what
+   * actually changed, so find the real changes with a single bitset
+   * operation and only map that range.
+   */
+  selection = gtk_selection_model_get_selection (self->model);
+  changes = gtk_bitset_copy (selection);
+  gtk_bitset_difference (changes, self->selection);
+  gtk_bitset_unref (selection);
+
+  if (gtk_bitset_is_empty (changes))
+    {
+      gtk_bitset_unref (changes);
+      return;
+    }
+
+  first = gtk_bitset_get_minimum (changes);
+  last = gtk_bitset_get_maximum (changes);
+  gtk_bitset_unref (changes);
+
+  selection_filter_model_items_changed (self, first, last - first + 1, last - first + 1);
 }
 
 static void
@@ -31,6 +31,7 @@
 #include "gtkcssnodeprivate.h"
 #include "gtkcssnumbervalueprivate.h"
 #include "gtklayoutmanagerprivate.h"
+#include "gtkpangoprivate.h"
 
 
 #ifdef G_ENABLE_CONSISTENCY_CHECKS
@@ -181,6 +182,9 @@ gtk_widget_query_size_for_orientation (GtkWidget        *widget,
       int css_extra_for_size;
       int css_extra_size;
       int widget_margins_for_size;
+      GtkWidgetProfilerSpan span;
+
+      gtk_widget_profiler_begin (&span);
 
       style = gtk_css_node_get_style (gtk_widget_get_css_node (widget));
       get_box_margin (style, &margin);
@@ -410,6 +414,8 @@ gtk_widget_query_size_for_orientation (GtkWidget        *widget,
                                       nat_size,
 				      min_baseline,
 				      nat_baseline);
+
+      gtk_widget_profiler_end (&span, widget, GTK_WIDGET_PHASE_MEASURE);
     }
 
   if (minimum)
@@ -751,6 +757,153 @@ compare_gap (gconstpointer p1,
   return delta;
 }
 
+/* Measuring the text of widgets on worker threads.
+ *
+ * Layout managers can call gtk_widget_prefetch_measure() before measuring
+ * a set of independent children. Widgets whose size only depends on a
+ * PangoLayout expose it via the get_measuring_layout() class hook, and
+ * those layouts get laid out in parallel. The results are cached, so the
+ * following measure() calls on the main thread find them without
+ * shaping any text.
+ *
+ * This is opt-in with GTK_PARALLEL_MEASURE=1, because it relies on the
+ * per-thread default font maps being configured like the main one.
+ * Text is measured on the main thread as usual if the default font
+ * map has been replaced or reconfigured.
+ */
+gboolean
+gtk_widget_can_prefetch_measure (void)
+{
+  static int enabled = -1;
+
+  if (G_UNLIKELY (enabled < 0))
+    {
+      const char *env = g_getenv ("GTK_PARALLEL_MEASURE");
+
+      enabled = env != NULL && g_strcmp0 (env, "0") != 0;
+    }
+
+  return enabled;
+}
+
+static PangoLayout *
+get_measuring_layout (GtkWidget      *widget,
+                      GtkOrientation  orientation,
+                      int             for_size)
+{
+  GtkWidgetClass *widget_class = GTK_WIDGET_GET_CLASS (widget);
+  SizeRequestCache *cache;
+  int dummy;
+
+  if (widget_class->priv->get_measuring_layout == NULL ||
+      !_gtk_widget_get_visible (widget) ||
+      _gtk_widget_get_sizegroups (widget) != NULL ||
+      gtk_widget_get_layout_manager (widget) != NULL)
+    return NULL;
+
+  cache = _gtk_widget_peek_request_cache (widget);
+  if (G_UNLIKELY (!cache->request_mode_valid))
+    {
+      cache->request_mode = fetch_request_mode (widget);
+      cache->request_mode_valid = TRUE;
+    }
+
+  if (cache->request_mode == GTK_SIZE_REQUEST_CONSTANT_SIZE)
+    for_size = -1;
+
+  if (_gtk_size_request_cache_lookup (cache, orientation, for_size,
+                                      &dummy, &dummy, &dummy, &dummy))
+    return NULL;
+
+  /* Adjust for_size the same way gtk_widget_query_size_for_orientation() does */
+  if (for_size >= 0)
+    {
+      GtkCssStyle *style;
+      GtkBorder margin, border, padding;
+      int minimum_for_size;
+      int css_min_for_size;
+      int css_extra_for_size;
+      int widget_margins_for_size;
+
+      style = gtk_css_node_get_style (gtk_widget_get_css_node (widget));
+      get_box_margin (style, &margin);
+      get_box_border (style, &border);
+      get_box_padding (style, &padding);
+
+      if (orientation == GTK_ORIENTATION_HORIZONTAL)
+        {
+          css_extra_for_size = margin.top + margin.bottom + border.top + border.bottom + padding.top + padding.bottom;
+          css_min_for_size = get_number_ceil (style->size->min_height);
+          widget_margins_for_size = widget->priv->margin.top + widget->priv->margin.bottom;
+        }
+      else
+        {
+          css_extra_for_size = margin.left + margin.right + border.left + border.right + padding.left + padding.right;
+          css_min_for_size = get_number_ceil (style->size->min_width);
+          widget_margins_for_size = widget->priv->margin.left + widget->priv->margin.right;
+        }
+
+      gtk_widget_measure (widget, OPPOSITE_ORIENTATION (orientation), -1,
+                          &minimum_for_size, NULL, NULL, NULL);
+
+      if (minimum_for_size < css_min_for_size)
+        minimum_for_size = css_min_for_size;
+
+      if (for_size < minimum_for_size)
+        for_size = minimum_for_size;
+
+      for_size -= widget_margins_for_size + css_extra_for_size;
+      if (for_size < 0)
+        for_size = minimum_for_size;
+    }
+
+  return widget_class->priv->get_measuring_layout (widget, orientation, for_size);
+}
+
+/*
+ * gtk_widget_prefetch_measure:
+ * @widgets: (array length=n_widgets): widgets that are about to be measured
+ * @for_sizes: (array length=n_widgets) (nullable): the for_size each widget
+ *   will be measured with, or %NULL for -1
+ * @n_widgets: the number of widgets
+ * @orientation: the orientation they will be measured in
+ *
+ * Measures the text of @widgets in parallel, so that measuring
+ * them afterwards is fast.
+ *
+ * This does not change the results of measuring, it only makes
+ * it faster for large amounts of text.
+ */
+void
+gtk_widget_prefetch_measure (GtkWidget      **widgets,
+                             const int       *for_sizes,
+                             guint            n_widgets,
+                             GtkOrientation   orientation)
+{
+  PangoLayout **layouts;
+  guint i, n_layouts;
+
+  if (!gtk_widget_can_prefetch_measure () || n_widgets < 2)
+    return;
+
+  layouts = g_newa (PangoLayout *, n_widgets);
+  n_layouts = 0;
+
+  for (i = 0; i < n_widgets; i++)
+    {
+      PangoLayout *layout;
+
+      layout = get_measuring_layout (widgets[i], orientation, for_sizes ? for_sizes[i] : -1);
+      if (layout)
+        layouts[n_layouts++] = layout;
+    }
+
+  gtk_pango_layout_prefetch_sizes (layouts, n_layouts);
+
+  for (i = 0; i < n_layouts; i++)
+    g_object_unref (layouts[i]);
+}
+
 /**
  * gtk_distribute_natural_allocation:
  * @extra_space: Extra space to redistribute among children after subtracting
@@ -31,23 +31,40 @@ _gtk_size_request_cache_init (SizeRequestCache *cache)
   memset (cache, 0, sizeof (SizeRequestCache));
 }
 
+/* The number of slots allocated for a cache holding @n_sizes
+ * entries. The cache only grows when it is full, so this can
+ * be derived instead of stored.
+ */
+static guint
+get_n_allocated_sizes (guint n_sizes)
+{
+  guint n_allocated = GTK_SIZE_REQUEST_CACHED_SIZES;
+
+  while (n_allocated < n_sizes)
+    n_allocated *= 2;
+
+  return n_allocated;
+}
+
 static void
-free_sizes_x (SizeRequestX **sizes)
+free_sizes_x (SizeRequestX **sizes,
+              guint          n_sizes)
 {
-  int i;
+  guint i;
 
-  for (i = 0; i < GTK_SIZE_REQUEST_CACHED_SIZES && sizes[i] != NULL; i++)
+  for (i = 0; i < n_sizes; i++)
     g_free (sizes[i]);
 
   g_free (sizes);
 }
 
 static void
-free_sizes_y (SizeRequestY **sizes)
+free_sizes_y (SizeRequestY **sizes,
+              guint          n_sizes)
 {
-  int i;
+  guint i;
 
-  for (i = 0; i < GTK_SIZE_REQUEST_CACHED_SIZES && sizes[i] != NULL; i++)
+  for (i = 0; i < n_sizes; i++)
     g_free (sizes[i]);
 
   g_free (sizes);
@@ -57,9 +74,45 @@ void
 _gtk_size_request_cache_free (SizeRequestCache *cache)
 {
   if (cache->requests_x)
-    free_sizes_x (cache->requests_x);
+    free_sizes_x (cache->requests_x, cache->flags[GTK_ORIENTATION_HORIZONTAL].n_cached_requests);
   if (cache->requests_y)
-    free_sizes_y (cache->requests_y);
+    free_sizes_y (cache->requests_y, cache->flags[GTK_ORIENTATION_VERTICAL].n_cached_requests);
+}
+
+/* Returns the index of the slot to store a new entry in. If the cache
+ * is full, it is grown up to GTK_SIZE_REQUEST_MAX_CACHED_SIZES before
+ * falling back to evicting entries round-robin.
+ */
+static guint
+next_cached_request (SizeRequestCache  *cache,
+                     GtkOrientation     orientation,
+                     gpointer         **requests)
+{
+  guint n_sizes = cache->flags[orientation].n_cached_requests;
+  guint n_allocated = get_n_allocated_sizes (n_sizes);
+
+  if (*requests == NULL)
+    *requests = g_new0 (gpointer, n_allocated);
+
+  if (n_sizes == n_allocated && n_allocated < GTK_SIZE_REQUEST_MAX_CACHED_SIZES)
+    {
+      *requests = g_renew (gpointer, *requests, n_allocated * 2);
+      memset (*requests + n_allocated, 0, n_allocated * sizeof (gpointer));
+      n_allocated *= 2;
+    }
+
+  if (n_sizes < n_allocated)
+    {
+      cache->flags[orientation].n_cached_requests++;
+      cache->flags[orientation].last_cached_request = n_sizes;
+    }
+  else
+    {
+      if (++cache->flags[orientation].last_cached_request == n_allocated)
+        cache->flags[orientation].last_cached_request = 0;
+    }
+
+  return cache->flags[orientation].last_cached_request;
 }
 
 void
@@ -159,26 +212,13 @@ _gtk_size_request_cache_commit (SizeRequestCache *cache,
 	}
 
       /* If not found, pull a new size from the cache, the returned size cache
-       * will immediately be used to cache the new computed size so we go ahead
-       * and increment the last_cached_request right away */
-      if (n_sizes < GTK_SIZE_REQUEST_CACHED_SIZES)
-	{
-	  cache->flags[orientation].n_cached_requests++;
-	  cache->flags[orientation].last_cached_request = cache->flags[orientation].n_cached_requests - 1;
-	}
-      else
-	{
-	  if (++cache->flags[orientation].last_cached_request == GTK_SIZE_REQUEST_CACHED_SIZES)
-	    cache->flags[orientation].last_cached_request = 0;
-	}
-
-      if (cache->requests_x == NULL)
-	cache->requests_x = g_new0 (SizeRequestX *, GTK_SIZE_REQUEST_CACHED_SIZES);
+       * will immediately be used to cache the new computed size */
+      i = next_cached_request (cache, orientation, (gpointer **) &cache->requests_x);
 
-      if (cache->requests_x[cache->flags[orientation].last_cached_request] == NULL)
-	cache->requests_x[cache->flags[orientation].last_cached_request] = g_new (SizeRequestX, 1);
+      if (cache->requests_x[i] == NULL)
+	cache->requests_x[i] = g_new (SizeRequestX, 1);
 
-      cached_size = cache->requests_x[cache->flags[orientation].last_cached_request];
+      cached_size = cache->requests_x[i];
       cached_size->lower_for_size = for_size;
       cached_size->upper_for_size = for_size;
       cached_size->cached_size.minimum_size = minimum_size;
@@ -232,26 +272,13 @@ _gtk_size_request_cache_commit (SizeRequestCache *cache,
 	}
 
       /* If not found, pull a new size from the cache, the returned size cache
-       * will immediately be used to cache the new computed size so we go ahead
-       * and increment the last_cached_request right away */
-      if (n_sizes < GTK_SIZE_REQUEST_CACHED_SIZES)
-	{
-	  cache->flags[orientation].n_cached_requests++;
-	  cache->flags[orientation].last_cached_request = cache->flags[orientation].n_cached_requests - 1;
-	}
-      else
-	{
-	  if (++cache->flags[orientation].last_cached_request == GTK_SIZE_REQUEST_CACHED_SIZES)
-	    cache->flags[orientation].last_cached_request = 0;
-	}
-
-      if (cache->requests_y == NULL)
-	cache->requests_y = g_new0 (SizeRequestY *, GTK_SIZE_REQUEST_CACHED_SIZES);
+       * will immediately be used to cache the new computed size */
+      i = next_cached_request (cache, orientation, (gpointer **) &cache->requests_y);
 
-      if (cache->requests_y[cache->flags[orientation].last_cached_request] == NULL)
-	cache->requests_y[cache->flags[orientation].last_cached_request] = g_new (SizeRequestY, 1);
+      if (cache->requests_y[i] == NULL)
+	cache->requests_y[i] = g_new (SizeRequestY, 1);
 
-      cached_size = cache->requests_y[cache->flags[orientation].last_cached_request];
+      cached_size = cache->requests_y[i];
       cached_size->lower_for_size = for_size;
       cached_size->upper_for_size = for_size;
       cached_size->cached_size.minimum_size = minimum_size;
@@ -34,8 +34,14 @@ G_BEGIN_DECLS
  * for a said widget to have, if a label can
  * only wrap to 3 lines, only 3 caches will
  * ever be allocated for it.
+ *
+ * Widgets that keep running out of cached sizes,
+ * like long wrapping labels in a resizing pane,
+ * get their cache doubled up to the maximum
+ * instead of evicting entries.
  */
-#define GTK_SIZE_REQUEST_CACHED_SIZES   (64)
+#define GTK_SIZE_REQUEST_CACHED_SIZES     (64)
+#define GTK_SIZE_REQUEST_MAX_CACHED_SIZES (1024)
 
 typedef struct {
   int minimum_size;
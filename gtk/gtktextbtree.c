@@ -731,6 +731,8 @@ _gtk_text_btree_delete (GtkTextIter *start,
   GtkTextLine *line;
   GtkTextLine *deleted_lines = NULL;        /* List of lines we've deleted */
   int start_byte_offset;
+  int pending_lines, pending_chars;         /* Count changes not yet applied
+                                             * to curnode and its parents */
 
   g_return_if_fail (start != NULL);
   g_return_if_fail (end != NULL);
@@ -791,6 +793,8 @@ _gtk_text_btree_delete (GtkTextIter *start,
 
   curline = start_line;
   curnode = curline->parent;
+  pending_lines = 0;
+  pending_chars = 0;
   while (seg != last_seg)
     {
       int char_count = 0;
@@ -813,15 +817,7 @@ _gtk_text_btree_delete (GtkTextIter *start,
               else
                 curnode->children.line = curline->next;
 
-              for (node = curnode; node != NULL;
-                   node = node->parent)
-                {
-                  /* Don't update node->num_chars, because
-                   * that was done when we deleted the segments.
-                   */
-                  node->num_lines -= 1;
-                }
-
+              pending_lines++;
               curnode->num_children -= 1;
               curline->next = deleted_lines;
               deleted_lines = curline;
@@ -830,6 +826,21 @@ _gtk_text_btree_delete (GtkTextIter *start,
           curline = nextline;
           seg = curline->segments;
 
+          /* Apply the count changes once per node instead of once
+           * per line or segment. This matters when deleting a lot
+           * of lines, like when trimming the start of a log.
+           */
+          if (curline->parent != curnode)
+            {
+              for (node = curnode; node != NULL; node = node->parent)
+                {
+                  node->num_lines -= pending_lines;
+                  node->num_chars -= pending_chars;
+                }
+              pending_lines = 0;
+              pending_chars = 0;
+            }
+
           /*
            * If the GtkTextBTreeNode is empty then delete it and its parents,
            * recursively upwards until a non-empty GtkTextBTreeNode is found.
@@ -906,18 +917,20 @@ _gtk_text_btree_delete (GtkTextIter *start,
         }
       else
         {
-          /* Segment is gone. Decrement the char count of the node and
-             all its parents. */
-          for (node = curnode; node != NULL;
-               node = node->parent)
-            {
-              node->num_chars -= char_count;
-            }
+          /* Segment is gone. The char count of the node and all
+             its parents gets decremented when leaving the node. */
+          pending_chars += char_count;
         }
 
       seg = next;
     }
 
+  for (node = curnode; node != NULL; node = node->parent)
+    {
+      node->num_lines -= pending_lines;
+      node->num_chars -= pending_chars;
+    }
+
   /*
    * If the beginning and end of the deletion range are in different
    * lines, join the two lines together and discard the ending line.
@@ -1100,6 +1113,8 @@ _gtk_text_btree_insert (GtkTextIter *iter,
                                         */
 
   int char_count_delta;                /* change to number of chars */
+  int end_byte_index;                  /* byte index of the end of the
+                                        * inserted text in its line */
   GtkTextBTree *tree;
   int start_byte_index;
   GtkTextLine *start_line;
@@ -1139,6 +1154,7 @@ _gtk_text_btree_insert (GtkTextIter *iter,
   sol = 0;
   line_count_delta = 0;
   char_count_delta = 0;
+  end_byte_index = start_byte_index;
   while (eol < len)
     {
       sol = eol;
@@ -1180,6 +1196,7 @@ _gtk_text_btree_insert (GtkTextIter *iter,
         {
           /* chunk didn't end with a paragraph separator */
           g_assert (eol == len);
+          end_byte_index += chunk_len;
           break;
         }
 
@@ -1196,6 +1213,7 @@ _gtk_text_btree_insert (GtkTextIter *iter,
       seg->next = NULL;
       line = newline;
       cur_seg = NULL;
+      end_byte_index = 0;
       line_count_delta++;
     }
 
@@ -1223,12 +1241,10 @@ _gtk_text_btree_insert (GtkTextIter *iter,
                                       &start,
                                       start_line,
                                       start_byte_index);
-    end = start;
-
-    /* We could almost certainly be more efficient here
-       by saving the information from the insertion loop
-       above. FIXME */
-    gtk_text_iter_forward_chars (&end, char_count_delta);
+    _gtk_text_btree_get_iter_at_line (tree,
+                                      &end,
+                                      line,
+                                      end_byte_index);
 
     DV (g_print ("invalidating due to inserting some text (%s)\n", G_STRLOC));
     _gtk_text_btree_invalidate_region (tree, &start, &end, FALSE);
@@ -1740,11 +1756,16 @@ queue_tag_redisplay (GtkTextBTree      *tree,
   /* We don't need to do anything if the tag doesn't affect display */
 }
 
-void
-_gtk_text_btree_tag (const GtkTextIter *start_orig,
-                     const GtkTextIter *end_orig,
-                     GtkTextTag        *tag,
-                     gboolean           add)
+/* Adds or removes toggles so that @tag covers or doesn't cover the
+ * ordered, non-empty range from @start to @end. This does not queue
+ * a redisplay, callers need to take care of that.
+ */
+static void
+gtk_text_btree_tag_range (GtkTextBTree      *tree,
+                          GtkTextTag        *tag,
+                          const GtkTextIter *start,
+                          const GtkTextIter *end,
+                          gboolean           add)
 {
   GtkTextLineSegment *seg, *prev;
   GtkTextLine *cleanupline;
@@ -1752,49 +1773,20 @@ _gtk_text_btree_tag (const GtkTextIter *start_orig,
   GtkTextLine *start_line;
   GtkTextLine *end_line;
   GtkTextIter iter;
-  GtkTextIter start, end;
-  GtkTextBTree *tree;
   IterStack *stack;
   GtkTextTagInfo *info;
 
-  g_return_if_fail (start_orig != NULL);
-  g_return_if_fail (end_orig != NULL);
-  g_return_if_fail (GTK_IS_TEXT_TAG (tag));
-  g_return_if_fail (_gtk_text_iter_get_btree (start_orig) ==
-                    _gtk_text_iter_get_btree (end_orig));
-  g_return_if_fail (tag->priv->table == _gtk_text_iter_get_btree (start_orig)->table);
-
-#if 0
-  printf ("%s tag %s from %d to %d\n",
-          add ? "Adding" : "Removing",
-          tag->name,
-          gtk_text_buffer_get_offset (start_orig),
-          gtk_text_buffer_get_offset (end_orig));
-#endif
-
-  if (gtk_text_iter_equal (start_orig, end_orig))
-    return;
-
-  start = *start_orig;
-  end = *end_orig;
-
-  gtk_text_iter_order (&start, &end);
-
-  tree = _gtk_text_iter_get_btree (&start);
-
-  queue_tag_redisplay (tree, tag, &start, &end);
-
   info = gtk_text_btree_get_tag_info (tree, tag);
 
-  start_line = _gtk_text_iter_get_text_line (&start);
-  end_line = _gtk_text_iter_get_text_line (&end);
+  start_line = _gtk_text_iter_get_text_line (start);
+  end_line = _gtk_text_iter_get_text_line (end);
 
   /* Find all tag toggles in the region; we are going to delete them.
      We need to find them in advance, because
      forward_find_tag_toggle () won't work once we start playing around
      with the tree. */
   stack = iter_stack_new ();
-  iter = start;
+  iter = *start;
 
   /* forward_to_tag_toggle() skips a toggle at the start iterator,
    * which is deliberate - we don't want to delete a toggle at the
@@ -1802,7 +1794,7 @@ _gtk_text_btree_tag (const GtkTextIter *start_orig,
    */
   while (gtk_text_iter_forward_to_tag_toggle (&iter, tag))
     {
-      if (gtk_text_iter_compare (&iter, &end) >= 0)
+      if (gtk_text_iter_compare (&iter, end) >= 0)
         break;
       else
         iter_stack_push (stack, &iter);
@@ -1817,7 +1809,7 @@ _gtk_text_btree_tag (const GtkTextIter *start_orig,
    * there.
    */
 
-  toggled_on = gtk_text_iter_has_tag (&start, tag);
+  toggled_on = gtk_text_iter_has_tag (start, tag);
   if ( (add && !toggled_on) ||
        (!add && toggled_on) )
     {
@@ -1825,7 +1817,7 @@ _gtk_text_btree_tag (const GtkTextIter *start_orig,
          cleanup_line () will remove it if so. */
       seg = _gtk_toggle_segment_new (info, add);
 
-      prev = gtk_text_line_segment_split (&start);
+      prev = gtk_text_line_segment_split (start);
       if (prev == NULL)
         {
           seg->next = start_line->segments;
@@ -1960,7 +1952,7 @@ _gtk_text_btree_tag (const GtkTextIter *start_orig,
 
       seg = _gtk_toggle_segment_new (info, !add);
 
-      prev = gtk_text_line_segment_split (&end);
+      prev = gtk_text_line_segment_split (end);
       if (prev == NULL)
         {
           seg->next = end_line->segments;
@@ -1990,7 +1982,121 @@ _gtk_text_btree_tag (const GtkTextIter *start_orig,
     }
 
   segments_changed (tree);
+}
+
+void
+_gtk_text_btree_tag (const GtkTextIter *start_orig,
+                     const GtkTextIter *end_orig,
+                     GtkTextTag        *tag,
+                     gboolean           add)
+{
+  GtkTextIter start, end;
+  GtkTextBTree *tree;
+
+  g_return_if_fail (start_orig != NULL);
+  g_return_if_fail (end_orig != NULL);
+  g_return_if_fail (GTK_IS_TEXT_TAG (tag));
+  g_return_if_fail (_gtk_text_iter_get_btree (start_orig) ==
+                    _gtk_text_iter_get_btree (end_orig));
+  g_return_if_fail (tag->priv->table == _gtk_text_iter_get_btree (start_orig)->table);
+
+#if 0
+  printf ("%s tag %s from %d to %d\n",
+          add ? "Adding" : "Removing",
+          tag->name,
+          gtk_text_buffer_get_offset (start_orig),
+          gtk_text_buffer_get_offset (end_orig));
+#endif
+
+  if (gtk_text_iter_equal (start_orig, end_orig))
+    return;
+
+  start = *start_orig;
+  end = *end_orig;
+
+  gtk_text_iter_order (&start, &end);
+
+  tree = _gtk_text_iter_get_btree (&start);
+
+  queue_tag_redisplay (tree, tag, &start, &end);
+
+  gtk_text_btree_tag_range (tree, tag, &start, &end, add);
+
+  queue_tag_redisplay (tree, tag, &start, &end);
+
+  if (GTK_DEBUG_CHECK (TEXT))
+    _gtk_text_btree_check (tree);
+}
+
+
+static inline int
+clamp_char_offset (int offset,
+                   int n_chars)
+{
+  /* -1 or anything past the end means the end, like for iters */
+  if (offset < 0 || offset > n_chars)
+    return n_chars;
+
+  return offset;
+}
+
+/* Like _gtk_text_btree_tag(), but for many ranges given as character
+ * offsets. The redisplay is queued once for the span of all ranges
+ * instead of twice per range, which matters when highlighting code
+ * applies thousands of tags at a time.
+ */
+void
+_gtk_text_btree_tag_ranges (GtkTextBTree *tree,
+                            GtkTextTag   *tag,
+                            const int    *starts,
+                            const int    *ends,
+                            guint         n_ranges,
+                            gboolean      add)
+{
+  GtkTextIter start, end;
+  int first, last;
+  int n_chars;
+  guint i;
+
+  g_return_if_fail (tree != NULL);
+  g_return_if_fail (GTK_IS_TEXT_TAG (tag));
+  g_return_if_fail (tag->priv->table == tree->table);
+
+  n_chars = _gtk_text_btree_char_count (tree);
+
+  first = G_MAXINT;
+  last = G_MININT;
+  for (i = 0; i < n_ranges; i++)
+    {
+      int s = clamp_char_offset (starts[i], n_chars);
+      int e = clamp_char_offset (ends[i], n_chars);
+
+      first = MIN (first, MIN (s, e));
+      last = MAX (last, MAX (s, e));
+    }
+
+  if (first >= last)
+    return;
+
+  _gtk_text_btree_get_iter_at_char (tree, &start, first);
+  _gtk_text_btree_get_iter_at_char (tree, &end, last);
+  queue_tag_redisplay (tree, tag, &start, &end);
+
+  for (i = 0; i < n_ranges; i++)
+    {
+      int s = clamp_char_offset (starts[i], n_chars);
+      int e = clamp_char_offset (ends[i], n_chars);
+
+      if (s == e)
+        continue;
+
+      _gtk_text_btree_get_iter_at_char (tree, &start, MIN (s, e));
+      _gtk_text_btree_get_iter_at_char (tree, &end, MAX (s, e));
+      gtk_text_btree_tag_range (tree, tag, &start, &end, add);
+    }
 
+  _gtk_text_btree_get_iter_at_char (tree, &start, first);
+  _gtk_text_btree_get_iter_at_char (tree, &end, last);
   queue_tag_redisplay (tree, tag, &start, &end);
 
   if (GTK_DEBUG_CHECK (TEXT))
@@ -113,6 +113,12 @@ void _gtk_text_btree_tag (const GtkTextIter *start,
                           const GtkTextIter *end,
                           GtkTextTag        *tag,
                           gboolean           apply);
+void _gtk_text_btree_tag_ranges (GtkTextBTree *tree,
+                                 GtkTextTag   *tag,
+                                 const int    *starts,
+                                 const int    *ends,
+                                 guint         n_ranges,
+                                 gboolean      apply);
 
 /* "Getters" */
 
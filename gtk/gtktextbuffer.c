@@ -73,12 +73,16 @@ struct _GtkTextBufferPrivate
 
   guint user_action_count;
 
+  int max_lines;
+
   /* Whether the buffer has been modified since last save */
   guint modified : 1;
   guint has_selection : 1;
   guint can_undo : 1;
   guint can_redo : 1;
   guint in_commit_notify : 1;
+  /* Lines need to be trimmed once the user action ends */
+  guint trim_pending : 1;
 };
 
 typedef struct _ClipboardRequest ClipboardRequest;
@@ -132,6 +136,7 @@ enum {
   PROP_CAN_UNDO,
   PROP_CAN_REDO,
   PROP_ENABLE_UNDO,
+  PROP_MAX_LINES,
   LAST_PROP
 };
 
@@ -171,6 +176,9 @@ static void gtk_text_buffer_commit_notify              (GtkTextBuffer     *buffe
 
 static GtkTextBTree* get_btree (GtkTextBuffer *buffer);
 static void          free_log_attr_cache (GtkTextLogAttrCache *cache);
+static void          gtk_text_buffer_emit_delete (GtkTextBuffer *buffer,
+                                                  GtkTextIter   *start,
+                                                  GtkTextIter   *end);
 
 static void remove_all_selection_clipboards       (GtkTextBuffer *buffer);
 static void update_selection_clipboards           (GtkTextBuffer *buffer);
@@ -599,6 +607,21 @@ gtk_text_buffer_class_init (GtkTextBufferClass *klass)
                         0,
                         GTK_PARAM_READABLE);
 
+  /**
+   * GtkTextBuffer:max-lines:
+   *
+   * The maximum number of lines to keep in the buffer, or 0 for no limit.
+   *
+   * See [method@Gtk.TextBuffer.set_max_lines].
+   *
+   * Since: 4.22
+   */
+  text_buffer_props[PROP_MAX_LINES] =
+      g_param_spec_int ("max-lines", NULL, NULL,
+                        0, G_MAXINT,
+                        0,
+                        GTK_PARAM_READWRITE|G_PARAM_EXPLICIT_NOTIFY);
+
   g_object_class_install_properties (object_class, LAST_PROP, text_buffer_props);
 
   /**
@@ -1044,6 +1067,10 @@ gtk_text_buffer_set_property (GObject         *object,
       gtk_text_buffer_set_enable_undo (text_buffer, g_value_get_boolean (value));
       break;
 
+    case PROP_MAX_LINES:
+      gtk_text_buffer_set_max_lines (text_buffer, g_value_get_int (value));
+      break;
+
     case PROP_TAG_TABLE:
       set_table (text_buffer, g_value_get_object (value));
       break;
@@ -1076,6 +1103,10 @@ gtk_text_buffer_get_property (GObject         *object,
       g_value_set_boolean (value, gtk_text_buffer_get_enable_undo (text_buffer));
       break;
 
+    case PROP_MAX_LINES:
+      g_value_set_int (value, text_buffer->priv->max_lines);
+      break;
+
     case PROP_TAG_TABLE:
       g_value_set_object (value, get_table (text_buffer));
       break;
@@ -1135,6 +1166,57 @@ gtk_text_buffer_new (GtkTextTagTable *table)
   return text_buffer;
 }
 
+/**
+ * gtk_text_buffer_new_from_bytes:
+ * @table: (nullable): a tag table, or %NULL to create a new one
+ * @bytes: UTF-8 text to fill the buffer with
+ *
+ * Creates a new text buffer containing the text in @bytes.
+ *
+ * This is the fastest way to load a large amount of text, as no
+ * signal handlers or views are connected yet and the text is not
+ * recorded in the undo history.
+ *
+ * To load a file without copying it into memory first, use
+ * [method@GLib.MappedFile.get_bytes].
+ *
+ * If @bytes is not valid UTF-8, %NULL is returned.
+ *
+ * Returns: (nullable): a new text buffer
+ *
+ * Since: 4.22
+ */
+GtkTextBuffer *
+gtk_text_buffer_new_from_bytes (GtkTextTagTable *table,
+                                GBytes          *bytes)
+{
+  GtkTextBuffer *text_buffer;
+  const char *text;
+  gsize len;
+  GtkTextIter iter;
+
+  g_return_val_if_fail (table == NULL || GTK_IS_TEXT_TAG_TABLE (table), NULL);
+  g_return_val_if_fail (bytes != NULL, NULL);
+
+  text = g_bytes_get_data (bytes, &len);
+  g_return_val_if_fail (len <= G_MAXINT, NULL);
+
+  if (!g_utf8_validate_len (text, len, NULL))
+    return NULL;
+
+  text_buffer = gtk_text_buffer_new (table);
+
+  /* Nobody can be listening yet, so skip the signal emission
+   * and the undo history and insert into the btree directly. */
+  if (len > 0)
+    {
+      gtk_text_buffer_get_start_iter (text_buffer, &iter);
+      _gtk_text_btree_insert (&iter, text, len);
+    }
+
+  return text_buffer;
+}
+
 static void
 gtk_text_buffer_finalize (GObject *object)
 {
@@ -1316,6 +1398,51 @@ gtk_text_buffer_emit_insert (GtkTextBuffer *buffer,
     }
 }
 
+/* Drops lines from the start of the buffer when it has more than
+ * max-lines lines, and revalidates @iter afterwards.
+ *
+ * Inside a user action, the trim is deferred to the end of the
+ * outermost user action. Trimming can't be undone, and the history
+ * can't record an irreversible action in the middle of a user action.
+ */
+static void
+gtk_text_buffer_trim_lines (GtkTextBuffer *buffer,
+                            GtkTextIter   *iter)
+{
+  GtkTextBufferPrivate *priv = buffer->priv;
+  GtkTextIter start, end;
+  int excess, offset;
+
+  if (priv->max_lines == 0)
+    return;
+
+  excess = gtk_text_buffer_get_line_count (buffer) - priv->max_lines;
+  if (excess <= 0)
+    return;
+
+  if (priv->user_action_count > 0)
+    {
+      priv->trim_pending = TRUE;
+      return;
+    }
+
+  offset = iter ? gtk_text_iter_get_offset (iter) : 0;
+
+  gtk_text_buffer_get_start_iter (buffer, &start);
+  gtk_text_buffer_get_iter_at_line (buffer, &end, excess);
+  offset -= gtk_text_iter_get_offset (&end);
+
+  /* Remove all excess lines in one go, so the btree and the views
+   * only have to handle a single deletion.
+   */
+  gtk_text_history_begin_irreversible_action (priv->history);
+  gtk_text_buffer_emit_delete (buffer, &start, &end);
+  gtk_text_history_end_irreversible_action (priv->history);
+
+  if (iter)
+    gtk_text_buffer_get_iter_at_offset (buffer, iter, MAX (offset, 0));
+}
+
 /**
  * gtk_text_buffer_insert:
  * @buffer: a `GtkTextBuffer`
@@ -1344,6 +1471,7 @@ gtk_text_buffer_insert (GtkTextBuffer *buffer,
   g_return_if_fail (gtk_text_iter_get_buffer (iter) == buffer);
 
   gtk_text_buffer_emit_insert (buffer, iter, text, len);
+  gtk_text_buffer_trim_lines (buffer, iter);
 }
 
 /**
@@ -1410,6 +1538,7 @@ gtk_text_buffer_insert_interactive (GtkTextBuffer *buffer,
       gtk_text_buffer_begin_user_action (buffer);
       gtk_text_buffer_emit_insert (buffer, iter, text, len);
       gtk_text_buffer_end_user_action (buffer);
+      gtk_text_buffer_trim_lines (buffer, iter);
       return TRUE;
     }
   else
@@ -1922,23 +2051,26 @@ gtk_text_buffer_insert_with_tags (GtkTextBuffer *buffer,
 
   start_offset = gtk_text_iter_get_offset (iter);
 
-  gtk_text_buffer_insert (buffer, iter, text, len);
+  /* Only trim once the tags are applied, the offset would be off otherwise */
+  gtk_text_buffer_emit_insert (buffer, iter, text, len);
 
-  if (first_tag == NULL)
-    return;
+  if (first_tag != NULL)
+    {
+      gtk_text_buffer_get_iter_at_offset (buffer, &start, start_offset);
 
-  gtk_text_buffer_get_iter_at_offset (buffer, &start, start_offset);
+      va_start (args, first_tag);
+      tag = first_tag;
+      while (tag)
+        {
+          gtk_text_buffer_apply_tag (buffer, tag, &start, iter);
 
-  va_start (args, first_tag);
-  tag = first_tag;
-  while (tag)
-    {
-      gtk_text_buffer_apply_tag (buffer, tag, &start, iter);
+          tag = va_arg (args, GtkTextTag*);
+        }
 
-      tag = va_arg (args, GtkTextTag*);
+      va_end (args);
     }
 
-  va_end (args);
+  gtk_text_buffer_trim_lines (buffer, iter);
 }
 
 /**
@@ -1976,35 +2108,36 @@ gtk_text_buffer_insert_with_tags_by_name  (GtkTextBuffer *buffer,
 
   start_offset = gtk_text_iter_get_offset (iter);
 
-  gtk_text_buffer_insert (buffer, iter, text, len);
+  gtk_text_buffer_emit_insert (buffer, iter, text, len);
 
-  if (first_tag_name == NULL)
-    return;
+  if (first_tag_name != NULL)
+    {
+      gtk_text_buffer_get_iter_at_offset (buffer, &start, start_offset);
 
-  gtk_text_buffer_get_iter_at_offset (buffer, &start, start_offset);
+      va_start (args, first_tag_name);
+      tag_name = first_tag_name;
+      while (tag_name)
+        {
+          GtkTextTag *tag;
 
-  va_start (args, first_tag_name);
-  tag_name = first_tag_name;
-  while (tag_name)
-    {
-      GtkTextTag *tag;
+          tag = gtk_text_tag_table_lookup (buffer->priv->tag_table,
+                                           tag_name);
 
-      tag = gtk_text_tag_table_lookup (buffer->priv->tag_table,
-                                       tag_name);
+          if (tag == NULL)
+            {
+              g_warning ("%s: no tag with name '%s'!", G_STRLOC, tag_name);
+              break;
+            }
 
-      if (tag == NULL)
-        {
-          g_warning ("%s: no tag with name '%s'!", G_STRLOC, tag_name);
-          va_end (args);
-          return;
-        }
+          gtk_text_buffer_apply_tag (buffer, tag, &start, iter);
 
-      gtk_text_buffer_apply_tag (buffer, tag, &start, iter);
+          tag_name = va_arg (args, const char *);
+        }
 
-      tag_name = va_arg (args, const char *);
+      va_end (args);
     }
 
-  va_end (args);
+  gtk_text_buffer_trim_lines (buffer, iter);
 }
 
 
@@ -3232,6 +3365,61 @@ gtk_text_buffer_remove_tag_by_name (GtkTextBuffer     *buffer,
   gtk_text_buffer_emit_tag (buffer, tag, FALSE, start, end);
 }
 
+/**
+ * gtk_text_buffer_apply_tag_ranges:
+ * @buffer: a `GtkTextBuffer`
+ * @tag: a `GtkTextTag`
+ * @starts: (array length=n_ranges): character offsets of one bound of each range
+ * @ends: (array length=n_ranges): character offsets of the other bound of each range
+ * @n_ranges: the number of ranges
+ *
+ * Applies @tag to many ranges at once.
+ *
+ * This is equivalent to calling [method@Gtk.TextBuffer.apply_tag] for
+ * each range, but much faster when applying a tag to thousands of
+ * ranges, as syntax highlighting does. Text views showing the buffer
+ * are only invalidated once for the span of all ranges.
+ *
+ * Offsets are interpreted like in [method@Gtk.TextBuffer.get_iter_at_offset],
+ * so -1 or an offset past the end refers to the end of the buffer. Ranges
+ * may be given in any order and may overlap.
+ *
+ * The [signal@Gtk.TextBuffer::apply-tag] signal is still emitted for
+ * each range if it has handlers connected.
+ *
+ * Since: 4.22
+ */
+void
+gtk_text_buffer_apply_tag_ranges (GtkTextBuffer *buffer,
+                                  GtkTextTag    *tag,
+                                  const int     *starts,
+                                  const int     *ends,
+                                  guint          n_ranges)
+{
+  g_return_if_fail (GTK_IS_TEXT_BUFFER (buffer));
+  g_return_if_fail (GTK_IS_TEXT_TAG (tag));
+  g_return_if_fail (n_ranges == 0 || (starts != NULL && ends != NULL));
+  g_return_if_fail (tag->priv->table == buffer->priv->tag_table);
+
+  if (GTK_TEXT_BUFFER_GET_CLASS (buffer)->apply_tag != gtk_text_buffer_real_apply_tag ||
+      g_signal_has_handler_pending (buffer, signals[APPLY_TAG], 0, FALSE))
+    {
+      GtkTextIter start, end;
+      guint i;
+
+      for (i = 0; i < n_ranges; i++)
+        {
+          gtk_text_buffer_get_iter_at_offset (buffer, &start, starts[i]);
+          gtk_text_buffer_get_iter_at_offset (buffer, &end, ends[i]);
+          gtk_text_buffer_emit_tag (buffer, tag, TRUE, &start, &end);
+        }
+
+      return;
+    }
+
+  _gtk_text_btree_tag_ranges (get_btree (buffer), tag, starts, ends, n_ranges, TRUE);
+}
+
 static int
 pointer_cmp (gconstpointer a,
              gconstpointer b)
@@ -4419,6 +4607,12 @@ gtk_text_buffer_end_user_action (GtkTextBuffer *buffer)
       /* Ended the outermost-nested user action end, so emit the signal */
       g_signal_emit (buffer, signals[END_USER_ACTION], 0);
       gtk_text_history_end_user_action (buffer->priv->history);
+
+      if (buffer->priv->trim_pending)
+        {
+          buffer->priv->trim_pending = FALSE;
+          gtk_text_buffer_trim_lines (buffer, NULL);
+        }
     }
 }
 
@@ -4925,7 +5119,7 @@ gtk_text_buffer_insert_with_attributes (GtkTextBuffer *buffer,
         end = start - 1; /* resulting in -1 to be passed to _insert */
 
       start_offset = gtk_text_iter_get_offset (iter);
-      gtk_text_buffer_insert (buffer, iter, text + start, end - start);
+      gtk_text_buffer_emit_insert (buffer, iter, text + start, end - start);
       gtk_text_buffer_get_iter_at_offset (buffer, &start_iter, start_offset);
 
       insert_tags_for_attributes (buffer, attr, &start_iter, iter);
@@ -4936,6 +5130,9 @@ gtk_text_buffer_insert_with_attributes (GtkTextBuffer *buffer,
 
   gtk_text_buffer_delete_mark (buffer, mark);
   pango_attr_iterator_destroy (attr);
+
+  /* Trim only after all runs are in, as we work with offsets above */
+  gtk_text_buffer_trim_lines (buffer, iter);
 }
 
 /**
@@ -5055,8 +5252,9 @@ gtk_text_buffer_history_insert (gpointer    funcs_data,
   GtkTextBuffer *buffer = funcs_data;
   GtkTextIter iter;
 
+  /* Don't trim here, the history replays changes by offset */
   gtk_text_buffer_get_iter_at_offset (buffer, &iter, begin);
-  gtk_text_buffer_insert (buffer, &iter, text, len);
+  gtk_text_buffer_emit_insert (buffer, &iter, text, len);
 }
 
 static void
@@ -5174,6 +5372,63 @@ gtk_text_buffer_set_enable_undo (GtkTextBuffer *buffer,
     }
 }
 
+/**
+ * gtk_text_buffer_set_max_lines:
+ * @buffer: a `GtkTextBuffer`
+ * @max_lines: the maximum number of lines, or 0 for no limit
+ *
+ * Limits the number of lines kept in the buffer.
+ *
+ * When text is inserted with [method@Gtk.TextBuffer.insert] or
+ * [method@Gtk.TextBuffer.insert_interactive] and the buffer ends up
+ * with more than @max_lines lines, lines are removed from the start
+ * of the buffer until it has @max_lines lines. This is useful for
+ * log viewers that keep appending output.
+ *
+ * Removing lines emits [signal@Gtk.TextBuffer::delete-range] and
+ * cannot be undone. It clears the undo history. If the text is inserted
+ * inside a user action, the lines are removed when the outermost user
+ * action ends, see [method@Gtk.TextBuffer.begin_user_action].
+ *
+ * If the buffer already has more lines, they are removed immediately.
+ *
+ * Since: 4.22
+ */
+void
+gtk_text_buffer_set_max_lines (GtkTextBuffer *buffer,
+                               int            max_lines)
+{
+  g_return_if_fail (GTK_IS_TEXT_BUFFER (buffer));
+  g_return_if_fail (max_lines >= 0);
+
+  if (buffer->priv->max_lines == max_lines)
+    return;
+
+  buffer->priv->max_lines = max_lines;
+
+  gtk_text_buffer_trim_lines (buffer, NULL);
+
+  g_object_notify_by_pspec (G_OBJECT (buffer), text_buffer_props[PROP_MAX_LINES]);
+}
+
+/**
+ * gtk_text_buffer_get_max_lines:
+ * @buffer: a `GtkTextBuffer`
+ *
+ * Gets the maximum number of lines kept in the buffer.
+ *
+ * Returns: the maximum number of lines, or 0 for no limit
+ *
+ * Since: 4.22
+ */
+int
+gtk_text_buffer_get_max_lines (GtkTextBuffer *buffer)
+{
+  g_return_val_if_fail (GTK_IS_TEXT_BUFFER (buffer), 0);
+
+  return buffer->priv->max_lines;
+}
+
 /**
  * gtk_text_buffer_begin_irreversible_action:
  * @buffer: a `GtkTextBuffer`
@@ -191,6 +191,9 @@ GType        gtk_text_buffer_get_type       (void) G_GNUC_CONST;
 /* table is NULL to create a new one */
 GDK_AVAILABLE_IN_ALL
 GtkTextBuffer *gtk_text_buffer_new            (GtkTextTagTable *table);
+GDK_AVAILABLE_IN_4_22
+GtkTextBuffer *gtk_text_buffer_new_from_bytes (GtkTextTagTable *table,
+                                               GBytes          *bytes);
 GDK_AVAILABLE_IN_ALL
 int            gtk_text_buffer_get_line_count (GtkTextBuffer   *buffer);
 GDK_AVAILABLE_IN_ALL
@@ -379,6 +382,12 @@ GDK_AVAILABLE_IN_ALL
 void gtk_text_buffer_remove_all_tags       (GtkTextBuffer     *buffer,
                                             const GtkTextIter *start,
                                             const GtkTextIter *end);
+GDK_AVAILABLE_IN_4_22
+void gtk_text_buffer_apply_tag_ranges      (GtkTextBuffer     *buffer,
+                                            GtkTextTag        *tag,
+                                            const int         *starts,
+                                            const int         *ends,
+                                            guint              n_ranges);
 
 
 /* You can either ignore the return value, or use it to
@@ -491,6 +500,11 @@ gboolean        gtk_text_buffer_get_enable_undo           (GtkTextBuffer *buffer
 GDK_AVAILABLE_IN_ALL
 void            gtk_text_buffer_set_enable_undo           (GtkTextBuffer *buffer,
                                                            gboolean       enable_undo);
+GDK_AVAILABLE_IN_4_22
+int             gtk_text_buffer_get_max_lines             (GtkTextBuffer *buffer);
+GDK_AVAILABLE_IN_4_22
+void            gtk_text_buffer_set_max_lines             (GtkTextBuffer *buffer,
+                                                           int            max_lines);
 GDK_AVAILABLE_IN_ALL
 guint           gtk_text_buffer_get_max_undo_levels       (GtkTextBuffer *buffer);
 GDK_AVAILABLE_IN_ALL
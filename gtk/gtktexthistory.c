@@ -36,8 +36,15 @@
  * gtk_text_history_end_irreversible_action() can be used to denote a
  * section of operations that cannot be undone. This will cause all previous
  * changes tracked by the GtkTextHistory to be discarded.
+ *
+ * Besides the number of undo levels, the history is bounded by the number
+ * of bytes of text it keeps around. Once that budget is exceeded, the
+ * oldest actions are dropped, so that replacing the contents of a large
+ * document cannot make the history grow without bounds.
  */
 
+#define DEFAULT_MAX_BYTES (32 * 1024 * 1024)
+
 typedef struct _Action     Action;
 typedef enum   _ActionKind ActionKind;
 
@@ -99,6 +106,9 @@ struct _GtkTextHistory
   guint               in_user;
   guint               max_undo_levels;
 
+  gsize               n_bytes;
+  gsize               max_bytes;
+
   guint               can_undo : 1;
   guint               can_redo : 1;
   guint               is_modified : 1;
@@ -308,6 +318,55 @@ action_free (Action *action)
   g_free (action);
 }
 
+static gsize
+action_get_n_bytes (const Action *action)
+{
+  gsize n_bytes = 0;
+
+  switch (action->kind)
+    {
+    case ACTION_KIND_INSERT:
+      return action->u.insert.istr.n_bytes;
+
+    case ACTION_KIND_DELETE_BACKSPACE:
+    case ACTION_KIND_DELETE_KEY:
+    case ACTION_KIND_DELETE_PROGRAMMATIC:
+    case ACTION_KIND_DELETE_SELECTION:
+      return action->u.delete.istr.n_bytes;
+
+    case ACTION_KIND_GROUP:
+      for (const GList *iter = action->u.group.actions.head; iter; iter = iter->next)
+        n_bytes += action_get_n_bytes (iter->data);
+      return n_bytes;
+
+    case ACTION_KIND_BARRIER:
+    default:
+      return 0;
+    }
+}
+
+static void
+gtk_text_history_drop_action (GtkTextHistory *self,
+                              GQueue         *queue,
+                              Action         *action)
+{
+  gsize n_bytes = action_get_n_bytes (action);
+
+  g_assert (self->n_bytes >= n_bytes);
+
+  self->n_bytes -= n_bytes;
+  g_queue_unlink (queue, &action->link);
+  action_free (action);
+}
+
+static void
+gtk_text_history_clear_queue (GtkTextHistory *self,
+                              GQueue         *queue)
+{
+  while (queue->length > 0)
+    gtk_text_history_drop_action (self, queue, g_queue_peek_head (queue));
+}
+
 static gboolean
 action_group_is_empty (const Action *action)
 {
@@ -332,9 +391,56 @@ action_group_is_empty (const Action *action)
 }
 
 static gboolean
-action_chain (Action   *action,
-              Action   *other,
-              gboolean  in_user_action)
+action_is_delete (const Action *action)
+{
+  return action->kind == ACTION_KIND_DELETE_BACKSPACE ||
+         action->kind == ACTION_KIND_DELETE_KEY ||
+         action->kind == ACTION_KIND_DELETE_PROGRAMMATIC ||
+         action->kind == ACTION_KIND_DELETE_SELECTION;
+}
+
+/* Deleting text from the end of an insertion made within the same
+ * group, as when correcting a typo with backspace, can be folded
+ * into the insertion since both are always undone together.
+ */
+static gboolean
+action_cancel_insert (GtkTextHistory *self,
+                      Action         *insert,
+                      Action         *other)
+{
+  guint begin = MIN (other->u.delete.begin, other->u.delete.end);
+  guint end = MAX (other->u.delete.begin, other->u.delete.end);
+  const char *str;
+  guint n_chars;
+  guint n_bytes;
+
+  g_assert (insert->kind == ACTION_KIND_INSERT);
+  g_assert (action_is_delete (other));
+
+  if (insert->is_modified_set ||
+      end != insert->u.insert.end ||
+      begin < insert->u.insert.begin)
+    return FALSE;
+
+  n_chars = begin - insert->u.insert.begin;
+  str = istring_str (&insert->u.insert.istr);
+  n_bytes = g_utf8_offset_to_pointer (str, n_chars) - str;
+
+  self->n_bytes -= insert->u.insert.istr.n_bytes - n_bytes;
+  self->n_bytes -= other->u.delete.istr.n_bytes;
+
+  istring_truncate (&insert->u.insert.istr, n_bytes, n_chars);
+  insert->u.insert.end = begin;
+  action_free (other);
+
+  return TRUE;
+}
+
+static gboolean
+action_chain (GtkTextHistory *self,
+              Action         *action,
+              Action         *other,
+              gboolean        in_user_action)
 {
   g_assert (action != NULL);
   g_assert (other != NULL);
@@ -369,10 +475,26 @@ action_chain (Action   *action,
        */
       if (tail != NULL && tail->kind == other->kind)
         {
-          if (action_chain (tail, other, in_user_action))
+          if (action_chain (self, tail, other, in_user_action))
             return TRUE;
         }
 
+      if (tail != NULL &&
+          tail->kind == ACTION_KIND_INSERT &&
+          action_is_delete (other))
+        {
+          if (action_cancel_insert (self, tail, other))
+            {
+              if (istring_empty (&tail->u.insert.istr))
+                {
+                  g_queue_unlink (&action->u.group.actions, &tail->link);
+                  action_free (tail);
+                }
+
+              return TRUE;
+            }
+        }
+
       g_queue_push_tail_link (&action->u.group.actions, &other->link);
 
       return TRUE;
@@ -437,7 +559,28 @@ action_chain (Action   *action,
        * have a group to coalesce. But unless each action deletes
        * a single character, the overhead isn't too bad as we embed
        * the strings in the action.
+       *
+       * Within a user action everything is undone at once, so
+       * adjacent deletions can be joined like the key variants.
        */
+      if (!in_user_action)
+        return FALSE;
+
+      if (action->u.delete.begin == other->u.delete.begin)
+        {
+          istring_append (&action->u.delete.istr, &other->u.delete.istr);
+          action->u.delete.end += other->u.delete.istr.n_chars;
+          action_free (other);
+          return TRUE;
+        }
+      else if (other->u.delete.end == action->u.delete.begin)
+        {
+          istring_prepend (&action->u.delete.istr, &other->u.delete.istr);
+          action->u.delete.begin = other->u.delete.begin;
+          action_free (other);
+          return TRUE;
+        }
+
       return FALSE;
 
     case ACTION_KIND_DELETE_SELECTION:
@@ -538,20 +681,34 @@ static void
 gtk_text_history_truncate_one (GtkTextHistory *self)
 {
   if (self->undo_queue.length > 0)
-    {
-      Action *action = g_queue_peek_head (&self->undo_queue);
-      g_queue_unlink (&self->undo_queue, &action->link);
-      action_free (action);
-    }
+    gtk_text_history_drop_action (self, &self->undo_queue, g_queue_peek_head (&self->undo_queue));
   else if (self->redo_queue.length > 0)
-    {
-      Action *action = g_queue_peek_tail (&self->redo_queue);
-      g_queue_unlink (&self->redo_queue, &action->link);
-      action_free (action);
-    }
+    gtk_text_history_drop_action (self, &self->redo_queue, g_queue_peek_tail (&self->redo_queue));
   else
+    g_assert_not_reached ();
+}
+
+/* Drops the oldest actions until we are within the byte budget.
+ * The most recent undo action is always kept, it may be a group
+ * that is still being filled by a user action.
+ */
+static void
+gtk_text_history_truncate_bytes (GtkTextHistory *self)
+{
+  while (self->n_bytes > self->max_bytes)
     {
-      g_assert_not_reached ();
+      Action *head = g_queue_peek_head (&self->undo_queue);
+      Action *tail = g_queue_peek_tail (&self->undo_queue);
+
+      if (tail != NULL && tail->kind == ACTION_KIND_BARRIER && tail->link.prev != NULL)
+        tail = tail->link.prev->data;
+
+      if (head != NULL && head != tail)
+        gtk_text_history_drop_action (self, &self->undo_queue, head);
+      else if (self->redo_queue.length > 0)
+        gtk_text_history_drop_action (self, &self->redo_queue, g_queue_peek_tail (&self->redo_queue));
+      else
+        break;
     }
 }
 
@@ -560,11 +717,14 @@ gtk_text_history_truncate (GtkTextHistory *self)
 {
   g_assert (GTK_IS_TEXT_HISTORY (self));
 
-  if (self->max_undo_levels == 0)
-    return;
+  if (self->max_undo_levels != 0)
+    {
+      while (self->undo_queue.length + self->redo_queue.length > self->max_undo_levels)
+        gtk_text_history_truncate_one (self);
+    }
 
-  while (self->undo_queue.length + self->redo_queue.length > self->max_undo_levels)
-    gtk_text_history_truncate_one (self);
+  if (self->max_bytes != 0)
+    gtk_text_history_truncate_bytes (self);
 }
 
 static void
@@ -572,8 +732,8 @@ gtk_text_history_finalize (GObject *object)
 {
   GtkTextHistory *self = (GtkTextHistory *)object;
 
-  clear_action_queue (&self->undo_queue);
-  clear_action_queue (&self->redo_queue);
+  gtk_text_history_clear_queue (self, &self->undo_queue);
+  gtk_text_history_clear_queue (self, &self->redo_queue);
 
   G_OBJECT_CLASS (gtk_text_history_parent_class)->finalize (object);
 }
@@ -590,6 +750,7 @@ static void
 gtk_text_history_init (GtkTextHistory *self)
 {
   self->enabled = TRUE;
+  self->max_bytes = DEFAULT_MAX_BYTES;
   self->selection.insert = -1;
   self->selection.bound = -1;
 }
@@ -650,17 +811,12 @@ gtk_text_history_push (GtkTextHistory *self,
   g_assert (self->enabled);
   g_assert (action != NULL);
 
-  while (self->redo_queue.length > 0)
-    {
-      peek = g_queue_peek_head (&self->redo_queue);
-      g_queue_unlink (&self->redo_queue, &peek->link);
-      action_free (peek);
-    }
+  gtk_text_history_clear_queue (self, &self->redo_queue);
 
   peek = g_queue_peek_tail (&self->undo_queue);
   in_user_action = self->in_user > 0;
 
-  if (peek == NULL || !action_chain (peek, action, in_user_action))
+  if (peek == NULL || !action_chain (self, peek, action, in_user_action))
     g_queue_push_tail_link (&self->undo_queue, &action->link);
 
   gtk_text_history_truncate (self);
@@ -951,7 +1107,7 @@ gtk_text_history_end_user_action (GtkTextHistory *self)
   return_if_applying (self);
   return_if_irreversible (self);
 
-  clear_action_queue (&self->redo_queue);
+  gtk_text_history_clear_queue (self, &self->redo_queue);
 
   peek = g_queue_peek_tail (&self->undo_queue);
 
@@ -973,8 +1129,7 @@ gtk_text_history_end_user_action (GtkTextHistory *self)
   /* Unlikely, but if the group is empty, just remove it */
   if (action_group_is_empty (peek))
     {
-      g_queue_unlink (&self->undo_queue, &peek->link);
-      action_free (peek);
+      gtk_text_history_drop_action (self, &self->undo_queue, peek);
       goto update_state;
     }
 
@@ -1023,8 +1178,8 @@ gtk_text_history_begin_irreversible_action (GtkTextHistory *self)
 
   self->irreversible++;
 
-  clear_action_queue (&self->undo_queue);
-  clear_action_queue (&self->redo_queue);
+  gtk_text_history_clear_queue (self, &self->undo_queue);
+  gtk_text_history_clear_queue (self, &self->redo_queue);
 
   gtk_text_history_update_state (self);
 }
@@ -1045,8 +1200,8 @@ gtk_text_history_end_irreversible_action (GtkTextHistory *self)
 
   self->irreversible--;
 
-  clear_action_queue (&self->undo_queue);
-  clear_action_queue (&self->redo_queue);
+  gtk_text_history_clear_queue (self, &self->undo_queue);
+  gtk_text_history_clear_queue (self, &self->redo_queue);
 
   gtk_text_history_update_state (self);
 }
@@ -1157,6 +1312,7 @@ gtk_text_history_text_inserted (GtkTextHistory *self,
   action->u.insert.begin = position;
   action->u.insert.end = position + n_chars;
   istring_set (&action->u.insert.istr, text, len, n_chars);
+  self->n_bytes += len;
 
   gtk_text_history_push (self, action);
 }
@@ -1195,6 +1351,7 @@ gtk_text_history_text_deleted (GtkTextHistory *self,
   action->u.delete.selection.insert = self->selection.insert;
   action->u.delete.selection.bound = self->selection.bound;
   istring_set (&action->u.delete.istr, text, len, MAX (end, begin) - MIN (end, begin));
+  self->n_bytes += len;
 
   gtk_text_history_push (self, action);
 }
@@ -1223,8 +1380,8 @@ gtk_text_history_set_enabled (GtkTextHistory *self,
         {
           self->irreversible = 0;
           self->in_user = 0;
-          clear_action_queue (&self->undo_queue);
-          clear_action_queue (&self->redo_queue);
+          gtk_text_history_clear_queue (self, &self->undo_queue);
+          gtk_text_history_clear_queue (self, &self->redo_queue);
         }
 
       gtk_text_history_update_state (self);
@@ -1251,3 +1408,25 @@ gtk_text_history_set_max_undo_levels (GtkTextHistory *self,
       gtk_text_history_truncate (self);
     }
 }
+
+gsize
+gtk_text_history_get_max_bytes (GtkTextHistory *self)
+{
+  g_return_val_if_fail (GTK_IS_TEXT_HISTORY (self), 0);
+
+  return self->max_bytes;
+}
+
+void
+gtk_text_history_set_max_bytes (GtkTextHistory *self,
+                                gsize           max_bytes)
+{
+  g_return_if_fail (GTK_IS_TEXT_HISTORY (self));
+
+  if (self->max_bytes != max_bytes)
+    {
+      self->max_bytes = max_bytes;
+      gtk_text_history_truncate (self);
+      gtk_text_history_update_state (self);
+    }
+}
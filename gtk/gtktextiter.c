@@ -4949,6 +4949,94 @@ strbreakup (const char *string,
   return str_array;
 }
 
+/* Needles that can not span a paragraph delimiter are searched for
+ * in chunks of whole lines instead of line by line. The chunks start
+ * with the remainder of the current line and double in size, so dense
+ * matches are still found after looking at a single line, while sparse
+ * matches in large buffers need few allocations and string scans.
+ */
+#define SEARCH_CHUNK_MAX_LINES 4096
+
+static gboolean
+needle_spans_lines (const char *needle)
+{
+  return strpbrk (needle, "\n\r") != NULL ||
+         strstr (needle, "\342\200\251") != NULL;
+}
+
+static gboolean
+forward_search_chunked (const GtkTextIter *iter,
+                        const char        *needle,
+                        gboolean           slice,
+                        gboolean           case_insensitive,
+                        GtkTextIter       *match_start,
+                        GtkTextIter       *match_end,
+                        const GtkTextIter *limit)
+{
+  GtkTextIter chunk_start;
+  GtkTextIter chunk_end;
+  int n_lines = 1;
+
+  chunk_start = *iter;
+
+  while (limit == NULL ||
+         gtk_text_iter_compare (&chunk_start, limit) < 0)
+    {
+      GtkTextIter start, end;
+      char *text;
+      const char *found;
+
+      chunk_end = chunk_start;
+      gtk_text_iter_forward_lines (&chunk_end, n_lines);
+      if (limit && gtk_text_iter_compare (&chunk_end, limit) > 0)
+        chunk_end = *limit;
+
+      /* No more text in buffer */
+      if (gtk_text_iter_equal (&chunk_start, &chunk_end))
+        break;
+
+      if (slice)
+        text = gtk_text_iter_get_slice (&chunk_start, &chunk_end);
+      else
+        text = gtk_text_iter_get_text (&chunk_start, &chunk_end);
+
+      if (!case_insensitive)
+        found = strstr (text, needle);
+      else
+        found = utf8_strcasestr (text, needle);
+
+      if (found == NULL)
+        {
+          g_free (text);
+          chunk_start = chunk_end;
+          n_lines = MIN (n_lines * 2, SEARCH_CHUNK_MAX_LINES);
+          continue;
+        }
+
+      start = chunk_start;
+      forward_chars_with_skipping (&start, g_utf8_strlen (text, found - text),
+                                   FALSE, !slice, FALSE);
+      end = start;
+      forward_chars_with_skipping (&end, g_utf8_strlen (needle, -1),
+                                   FALSE, !slice, case_insensitive);
+
+      g_free (text);
+
+      /* Matches are found in order, so later ones end past the limit too */
+      if (limit && gtk_text_iter_compare (&end, limit) > 0)
+        return FALSE;
+
+      if (match_start)
+        *match_start = start;
+      if (match_end)
+        *match_end = end;
+
+      return TRUE;
+    }
+
+  return FALSE;
+}
+
 /**
  * gtk_text_iter_forward_search:
  * @iter: start of search
@@ -5023,6 +5111,17 @@ gtk_text_iter_forward_search (const GtkTextIter *iter,
 
   lines = strbreakup (str, "\n", -1, NULL, case_insensitive);
 
+  if (!visible_only &&
+      lines[0] != NULL && lines[1] == NULL &&
+      !needle_spans_lines (lines[0]))
+    {
+      retval = forward_search_chunked (iter, lines[0], slice, case_insensitive,
+                                       match_start, match_end, limit);
+      g_strfreev ((char **)lines);
+
+      return retval;
+    }
+
   search = *iter;
 
   do
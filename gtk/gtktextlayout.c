@@ -3773,14 +3773,20 @@ gtk_text_layout_after_buffer_delete_range (GtkTextBuffer *textbuffer,
   gtk_text_layout_update_cursor_line (layout);
 }
 
+/* Paragraphs with at least this many characters are only rendered
+ * around the visible area, see gtk_text_layout_snapshot().
+ */
+#define PARTIAL_RENDER_MIN_CHARS 10000
+
 static void
-render_para (GskPangoRenderer   *crenderer,
-             GtkTextLineDisplay *line_display,
-             int                 selection_start_index,
-             int                 selection_end_index,
-             const GdkColor     *selection_color,
-             gboolean            draw_selection_text,
-             float               cursor_alpha)
+render_para (GskPangoRenderer      *crenderer,
+             GtkTextLineDisplay    *line_display,
+             int                    selection_start_index,
+             int                    selection_end_index,
+             const GdkColor        *selection_color,
+             gboolean               draw_selection_text,
+             float                  cursor_alpha,
+             const graphene_rect_t *area)
 {
   PangoLayout *layout = line_display->layout;
   int byte_offset = 0;
@@ -3827,6 +3833,14 @@ render_para (GskPangoRenderer   *crenderer,
       if (at_last_line)
         selection_height += line_display->bottom_margin;
 
+      if (area != NULL &&
+          (selection_y + selection_height < area->origin.y ||
+           selection_y > area->origin.y + area->size.height))
+        {
+          byte_offset += pango_layout_line_get_length (line);
+          continue;
+        }
+
       /* Don't draw the text underneath if the whole line is selected. We can
        * only do it if the selection is opaque.
        */
@@ -4021,6 +4035,7 @@ gtk_text_layout_snapshot (GtkTextLayout         *layout,
   GtkTextLayoutPrivate *priv;
   GskPangoRenderer *crenderer;
   int offset_y;
+  int first_line_y;
   GtkTextIter selection_start, selection_end;
   int selection_start_line;
   int selection_end_line;
@@ -4058,6 +4073,7 @@ gtk_text_layout_snapshot (GtkTextLayout         *layout,
   style = gtk_css_node_get_style (node);
 
   gtk_snapshot_translate (snapshot, &GRAPHENE_POINT_INIT (0, offset_y));
+  first_line_y = offset_y;
   offset_y = 0;
 
   cursor_snapshot = NULL;
@@ -4106,9 +4122,18 @@ gtk_text_layout_snapshot (GtkTextLayout         *layout,
       GtkTextLineDisplay *line_display;
       int selection_start_index = -1;
       int selection_end_index = -1;
+      graphene_rect_t line_clip;
+      gboolean partial;
 
       line_display = gtk_text_layout_get_line_display (layout, line, FALSE);
 
+      /* The clip, relative to the top of this paragraph */
+      graphene_rect_init (&line_clip,
+                          clip->origin.x,
+                          clip->origin.y - first_line_y - offset_y,
+                          clip->size.width,
+                          clip->size.height);
+
       if (line_display->height > 0)
         {
           g_assert (line_display->layout != NULL);
@@ -4160,20 +4185,46 @@ gtk_text_layout_snapshot (GtkTextLayout         *layout,
                 {
                   g_clear_pointer (&line_display->node, gsk_render_node_unref);
                 }
+
+              /* Scrolled away from the part that was rendered */
+              if (line_display->node_is_partial &&
+                  !graphene_rect_contains_rect (&line_display->node_area, &line_clip))
+                g_clear_pointer (&line_display->node, gsk_render_node_unref);
             }
 
+          /* Huge paragraphs, such as minified files without newlines,
+           * would produce enormous render nodes. We only render the
+           * part around the visible area for them, with a screenful
+           * of slack in each direction so that scrolling can reuse
+           * the node for a while.
+           */
+          partial = pango_layout_get_character_count (line_display->layout) >= PARTIAL_RENDER_MIN_CHARS;
+
           if (line_display->node == NULL &&
               (pango_layout_get_character_count (line_display->layout) > 0 ||
                selection_start_index != -1 || selection_end_index != -1 ||
                line_display->has_block_cursor))
             {
+              if (partial)
+                {
+                  graphene_rect_inset_r (&line_clip,
+                                         -line_clip.size.width,
+                                         -line_clip.size.height,
+                                         &line_display->node_area);
+                  gsk_pango_renderer_set_cull_rect (crenderer, &line_display->node_area);
+                }
+
               gtk_snapshot_push_collect (snapshot);
               render_para (crenderer, line_display,
                            selection_start_index, selection_end_index,
                            &selection_color,
                            draw_selection_text,
-                           cursor_alpha);
+                           cursor_alpha,
+                           partial ? &line_display->node_area : NULL);
               line_display->node = gtk_snapshot_pop_collect (snapshot);
+              line_display->node_is_partial = partial;
+
+              gsk_pango_renderer_set_cull_rect (crenderer, NULL);
             }
 
           if (line_display->node != NULL)
@@ -4240,8 +4291,9 @@ gtk_text_layout_snapshot (GtkTextLayout         *layout,
         }
     }
 
-  /* Only update eviction source once per snapshot */
+  /* Only update eviction source and profiler counters once per snapshot */
   gtk_text_line_display_cache_delay_eviction (priv->cache);
+  gtk_text_line_display_cache_report_stats ();
 
   gdk_color_finish (&crenderer->fg_color);
 
@@ -4275,3 +4327,65 @@ gtk_text_layout_set_mru_size (GtkTextLayout *layout,
 
   gtk_text_line_display_cache_set_mru_size (priv->cache, mru_size);
 }
+
+/*
+ * gtk_text_layout_prefetch:
+ * @layout: a `GtkTextLayout`
+ * @top_y: top of the area to prefetch
+ * @bottom_y: bottom of the area to prefetch
+ * @deadline: monotonic time after which to stop
+ *
+ * Creates the displays for the lines between @top_y and @bottom_y,
+ * so that they are found in the display cache when they get
+ * scrolled into view.
+ *
+ * Returns: %TRUE if all lines in the area have been prefetched
+ */
+gboolean
+gtk_text_layout_prefetch (GtkTextLayout *layout,
+                          int            top_y,
+                          int            bottom_y,
+                          gint64         deadline)
+{
+  GtkTextBTree *btree;
+  GtkTextLine *line;
+  GtkTextLine *last_line;
+
+  g_return_val_if_fail (GTK_IS_TEXT_LAYOUT (layout), TRUE);
+
+  top_y = MAX (top_y, 0);
+  if (bottom_y <= top_y)
+    return TRUE;
+
+  btree = _gtk_text_buffer_get_btree (layout->buffer);
+
+  line = _gtk_text_btree_find_line_by_y (btree, layout, top_y, NULL);
+  if (line == NULL)
+    return TRUE;
+
+  last_line = _gtk_text_btree_find_line_by_y (btree, layout, bottom_y - 1, NULL);
+  if (last_line == NULL)
+    last_line = _gtk_text_btree_get_end_iter_line (btree);
+
+  for (; line != NULL; line = _gtk_text_line_next_excluding_last (line))
+    {
+      gtk_text_line_display_unref (gtk_text_layout_get_line_display (layout, line, FALSE));
+
+      if (line == last_line)
+        return TRUE;
+
+      if (g_get_monotonic_time () >= deadline)
+        return FALSE;
+    }
+
+  return TRUE;
+}
+
+void
+gtk_text_layout_get_display_cache_stats (GtkTextLayout                *layout,
+                                         GtkTextLineDisplayCacheStats *stats)
+{
+  GtkTextLayoutPrivate *priv = GTK_TEXT_LAYOUT_GET_PRIVATE (layout);
+
+  gtk_text_line_display_cache_get_stats (priv->cache, stats);
+}
@@ -99,6 +99,7 @@ typedef struct _GtkTextLayout         GtkTextLayout;
 typedef struct _GtkTextLayoutClass    GtkTextLayoutClass;
 typedef struct _GtkTextLineDisplay    GtkTextLineDisplay;
 typedef struct _GtkTextAttrAppearance GtkTextAttrAppearance;
+typedef struct _GtkTextLineDisplayCacheStats GtkTextLineDisplayCacheStats;
 
 struct _GtkTextLayout
 {
@@ -170,6 +171,8 @@ struct _GtkTextLineDisplay
   PangoLayout *layout;
 
   GskRenderNode *node;
+  /* The area covered by node, if it only covers part of the paragraph */
+  graphene_rect_t node_area;
 
   GArray *cursors;      /* indexes of cursors in the PangoLayout, and mark names */
 
@@ -204,6 +207,7 @@ struct _GtkTextLineDisplay
   guint size_only : 1;
   guint pg_bg_rgba_set : 1;
   guint has_children : 1;
+  guint node_is_partial : 1;
 
   GdkRGBA pg_bg_rgba;
 };
@@ -373,6 +377,12 @@ void gtk_text_layout_snapshot (GtkTextLayout         *layout,
 
 void gtk_text_layout_set_mru_size (GtkTextLayout *layout,
                                    guint          mru_size);
+gboolean gtk_text_layout_prefetch (GtkTextLayout *layout,
+                                   int            top_y,
+                                   int            bottom_y,
+                                   gint64         deadline);
+void gtk_text_layout_get_display_cache_stats (GtkTextLayout                *layout,
+                                              GtkTextLineDisplayCacheStats *stats);
 
 G_END_DECLS
 
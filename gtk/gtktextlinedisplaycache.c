@@ -25,10 +25,19 @@
 #include "gtktextlinedisplaycacheprivate.h"
 #include "gtkprivate.h"
 
+#include "gdk/gdkprofilerprivate.h"
+
 #define DEFAULT_MRU_SIZE         250
+#define MAX_MRU_SIZE             4000
 #define BLOW_CACHE_TIMEOUT_SEC   20
 #define DEBUG_LINE_DISPLAY_CACHE 0
 
+/* Upper bound for the number of characters laid out by the cached
+ * displays. A few very long lines can use as much memory as thousands
+ * of short ones, so the MRU is culled when either limit is reached.
+ */
+#define MAX_CACHED_CHARS         (4 * 1024 * 1024)
+
 struct _GtkTextLineDisplayCache
 {
   GSequence   *sorted_by_line;
@@ -37,44 +46,50 @@ struct _GtkTextLineDisplayCache
   GQueue       mru;
   GSource     *evict_source;
   guint        mru_size;
+  gsize        n_chars;
+
+  GtkTextLineDisplayCacheStats stats;
 
 #if DEBUG_LINE_DISPLAY_CACHE
   guint       log_source;
-  int         hits;
-  int         misses;
-  int         inval;
-  int         inval_cursors;
-  int         inval_by_line;
-  int         inval_by_range;
-  int         inval_by_y_range;
 #endif
 };
 
 static GQueue purge_in_idle;
 static guint purge_in_idle_source;
 
+static guint hits_counter;
+static guint misses_counter;
+static guint64 total_hits;
+static guint64 total_misses;
+
+#define STAT_ADD(val,n) ((val) += n)
+#define STAT_INC(val)   STAT_ADD(val,1)
+
 #if DEBUG_LINE_DISPLAY_CACHE
-# define STAT_ADD(val,n) ((val) += n)
-# define STAT_INC(val)   STAT_ADD(val,1)
 static gboolean
 dump_stats (gpointer data)
 {
   GtkTextLineDisplayCache *cache = data;
-  g_printerr ("%p: size=%u hits=%d misses=%d inval_total=%d "
-              "inval_cursors=%d inval_by_line=%d "
-              "inval_by_range=%d inval_by_y_range=%d\n",
+  g_printerr ("%p: size=%u hits=%"G_GUINT64_FORMAT" misses=%"G_GUINT64_FORMAT" "
+              "inval_total=%"G_GUINT64_FORMAT" "
+              "inval_cursors=%"G_GUINT64_FORMAT" inval_by_line=%"G_GUINT64_FORMAT" "
+              "inval_by_range=%"G_GUINT64_FORMAT" inval_by_y_range=%"G_GUINT64_FORMAT"\n",
               cache, g_hash_table_size (cache->line_to_display),
-              cache->hits, cache->misses,
-              cache->inval, cache->inval_cursors,
-              cache->inval_by_line, cache->inval_by_range,
-              cache->inval_by_y_range);
+              cache->stats.hits, cache->stats.misses,
+              cache->stats.inval, cache->stats.inval_cursors,
+              cache->stats.inval_by_line, cache->stats.inval_by_range,
+              cache->stats.inval_by_y_range);
   return G_SOURCE_CONTINUE;
 }
-#else
-# define STAT_ADD(val,n)
-# define STAT_INC(val)
 #endif
 
+static inline gsize
+display_n_chars (GtkTextLineDisplay *display)
+{
+  return display->layout ? pango_layout_get_character_count (display->layout) : 0;
+}
+
 GtkTextLineDisplayCache *
 gtk_text_line_display_cache_new (void)
 {
@@ -85,6 +100,14 @@ gtk_text_line_display_cache_new (void)
   ret->line_to_display = g_hash_table_new (NULL, NULL);
   ret->mru_size = DEFAULT_MRU_SIZE;
 
+  if (hits_counter == 0)
+    {
+      hits_counter = gdk_profiler_define_int_counter ("textview-display-cache-hits",
+                                                      "Text line display cache hits");
+      misses_counter = gdk_profiler_define_int_counter ("textview-display-cache-misses",
+                                                        "Text line display cache misses");
+    }
+
 #if DEBUG_LINE_DISPLAY_CACHE
   ret->log_source = g_timeout_add_seconds (1, dump_stats, ret);
 #endif
@@ -206,9 +229,11 @@ gtk_text_line_display_cache_take_display (GtkTextLineDisplayCache *cache,
                               layout);
   g_hash_table_insert (cache->line_to_display, display->line, display);
   g_queue_push_head_link (&cache->mru, &display->mru_link);
+  cache->n_chars += display_n_chars (display);
 
   /* Cull the cache if we're at capacity */
-  while (cache->mru.length > cache->mru_size)
+  while (cache->mru.length > cache->mru_size ||
+         (cache->n_chars > MAX_CACHED_CHARS && cache->mru.length > 1))
     {
       display = g_queue_peek_tail (&cache->mru);
 
@@ -278,6 +303,7 @@ gtk_text_line_display_cache_invalidate_display (GtkTextLineDisplayCache *cache,
 
       g_hash_table_remove (cache->line_to_display, display->line);
       g_queue_unlink (&cache->mru, &display->mru_link);
+      cache->n_chars -= display_n_chars (display);
 
       if (iter != NULL)
         {
@@ -304,7 +330,7 @@ gtk_text_line_display_cache_invalidate_display (GtkTextLineDisplayCache *cache,
         }
     }
 
-  STAT_INC (cache->inval);
+  STAT_INC (cache->stats.inval);
 }
 
 /*
@@ -344,7 +370,8 @@ gtk_text_line_display_cache_get (GtkTextLineDisplayCache *cache,
     {
       if (size_only || !display->size_only)
         {
-          STAT_INC (cache->hits);
+          STAT_INC (cache->stats.hits);
+          total_hits++;
 
           if (!size_only && display->line == cache->cursor_line)
             gtk_text_layout_update_display_cursors (layout, display->line, display);
@@ -369,7 +396,8 @@ gtk_text_line_display_cache_get (GtkTextLineDisplayCache *cache,
       gtk_text_line_display_cache_invalidate_display (cache, display, FALSE);
     }
 
-  STAT_INC (cache->misses);
+  STAT_INC (cache->stats.misses);
+  total_misses++;
 
   g_assert (!g_hash_table_lookup (cache->line_to_display, line));
 
@@ -406,7 +434,7 @@ gtk_text_line_display_cache_invalidate (GtkTextLineDisplayCache *cache)
   g_assert (cache->sorted_by_line != NULL);
   g_assert (cache->line_to_display != NULL);
 
-  STAT_ADD (cache->inval, g_hash_table_size (cache->line_to_display));
+  STAT_ADD (cache->stats.inval, g_hash_table_size (cache->line_to_display));
 
   cache->cursor_line = NULL;
 
@@ -431,7 +459,7 @@ gtk_text_line_display_cache_invalidate_cursors (GtkTextLineDisplayCache *cache,
   g_assert (cache != NULL);
   g_assert (line != NULL);
 
-  STAT_INC (cache->inval_cursors);
+  STAT_INC (cache->stats.inval_cursors);
 
   display = g_hash_table_lookup (cache->line_to_display, line);
 
@@ -463,7 +491,7 @@ gtk_text_line_display_cache_invalidate_line (GtkTextLineDisplayCache *cache,
   if (display != NULL)
     gtk_text_line_display_cache_invalidate_display (cache, display, FALSE);
 
-  STAT_INC (cache->inval_by_line);
+  STAT_INC (cache->stats.inval_by_line);
 }
 
 static GSequenceIter *
@@ -564,7 +592,7 @@ gtk_text_line_display_cache_invalidate_range (GtkTextLineDisplayCache *cache,
   g_assert (begin != NULL);
   g_assert (end != NULL);
 
-  STAT_INC (cache->inval_by_range);
+  STAT_INC (cache->stats.inval_by_range);
 
   /* Short-circuit, is_empty() is O(1) */
   if (g_sequence_is_empty (cache->sorted_by_line))
@@ -732,7 +760,7 @@ gtk_text_line_display_cache_invalidate_y_range (GtkTextLineDisplayCache *cache,
   g_assert (cache != NULL);
   g_assert (layout != NULL);
 
-  STAT_INC (cache->inval_by_y_range);
+  STAT_INC (cache->stats.inval_by_y_range);
 
   /* A common pattern is to invalidate the whole buffer using y==0 and
    * old_height==new_height. So special case that instead of walking through
@@ -811,6 +839,8 @@ gtk_text_line_display_cache_set_mru_size (GtkTextLineDisplayCache *cache,
 
   if (mru_size == 0)
     mru_size = DEFAULT_MRU_SIZE;
+  else
+    mru_size = MIN (mru_size, MAX_MRU_SIZE);
 
   if (mru_size != cache->mru_size)
     {
@@ -824,3 +854,28 @@ gtk_text_line_display_cache_set_mru_size (GtkTextLineDisplayCache *cache,
         }
     }
 }
+
+/* Pushes the hit and miss counts of all caches to the profiler.
+ * This is called once per frame, not on every lookup. */
+void
+gtk_text_line_display_cache_report_stats (void)
+{
+  if (!GDK_PROFILER_IS_RUNNING)
+    return;
+
+  gdk_profiler_set_int_counter (hits_counter, total_hits);
+  gdk_profiler_set_int_counter (misses_counter, total_misses);
+}
+
+void
+gtk_text_line_display_cache_get_stats (GtkTextLineDisplayCache      *cache,
+                                       GtkTextLineDisplayCacheStats *stats)
+{
+  g_assert (cache != NULL);
+  g_assert (stats != NULL);
+
+  *stats = cache->stats;
+  stats->size = cache->mru.length;
+  stats->mru_size = cache->mru_size;
+  stats->n_chars = cache->n_chars;
+}
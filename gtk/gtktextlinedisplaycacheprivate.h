@@ -25,6 +25,20 @@ G_BEGIN_DECLS
 
 typedef struct _GtkTextLineDisplayCache GtkTextLineDisplayCache;
 
+struct _GtkTextLineDisplayCacheStats
+{
+  guint   size;
+  guint   mru_size;
+  gsize   n_chars;
+  guint64 hits;
+  guint64 misses;
+  guint64 inval;
+  guint64 inval_cursors;
+  guint64 inval_by_line;
+  guint64 inval_by_range;
+  guint64 inval_by_y_range;
+};
+
 GtkTextLineDisplayCache *gtk_text_line_display_cache_new                (void);
 void                     gtk_text_line_display_cache_free               (GtkTextLineDisplayCache *cache);
 GtkTextLineDisplay      *gtk_text_line_display_cache_get                (GtkTextLineDisplayCache *cache,
@@ -55,6 +69,9 @@ void                     gtk_text_line_display_cache_invalidate_y_range (GtkText
                                                                          gboolean                 cursors_only);
 void                     gtk_text_line_display_cache_set_mru_size       (GtkTextLineDisplayCache *cache,
                                                                          guint                    mru_size);
+void                     gtk_text_line_display_cache_get_stats          (GtkTextLineDisplayCache      *cache,
+                                                                         GtkTextLineDisplayCacheStats *stats);
+void                     gtk_text_line_display_cache_report_stats       (void);
 
 G_END_DECLS
 
@@ -273,6 +273,9 @@ struct _GtkTextViewPrivate
 
   guint first_validate_idle;        /* Idle to revalidate onscreen portion, runs before resize */
   guint incremental_validate_idle;  /* Idle to revalidate offscreen portions, runs after redraw */
+  guint incremental_validate_work;  /* Same, but in the time left at the end of frames */
+  GdkFrameClock *validate_frame_clock;
+  guint prefetch_idle;              /* Idle to create displays next to the visible area */
 
   /* Mark for drop target */
   GtkTextMark *dnd_mark;
@@ -4159,6 +4162,16 @@ gtk_text_view_remove_validate_idles (GtkTextView *text_view)
       g_source_remove (priv->incremental_validate_idle);
       priv->incremental_validate_idle = 0;
     }
+
+  if (priv->incremental_validate_work != 0)
+    {
+      gdk_frame_clock_remove_work (priv->validate_frame_clock,
+                                   priv->incremental_validate_work);
+      priv->incremental_validate_work = 0;
+    }
+  g_clear_object (&priv->validate_frame_clock);
+
+  g_clear_handle_id (&priv->prefetch_idle, g_source_remove);
 }
 
 static void
@@ -5083,25 +5096,107 @@ first_validate_callback (gpointer data)
   return FALSE;
 }
 
+/* How long a single run of incremental validation may take, in µs.
+ * This is well below a frame, so that validating huge buffers keeps
+ * up with animations, but large enough that we don't update the
+ * adjustments after every couple of lines.
+ */
+#define INCREMENTAL_VALIDATE_BUDGET 4000
+
+/* Lays out half a screen above and below the visible area, so that
+ * scrolling finds the lines in the display cache. The cache holds
+ * about three screens worth of lines, so this doesn't evict the
+ * visible lines.
+ */
 static gboolean
-incremental_validate_callback (gpointer data)
+prefetch_callback (gpointer data)
 {
   GtkTextView *text_view = data;
-  gboolean result = TRUE;
+  GtkTextViewPrivate *priv = text_view->priv;
+  int top, height;
+  gint64 deadline;
 
-  DV(g_print(G_STRLOC"\n"));
+  /* Incremental validation queues us again when it is done */
+  if (priv->layout == NULL ||
+      !gtk_text_layout_is_valid (priv->layout) ||
+      !gtk_widget_get_mapped (GTK_WIDGET (text_view)))
+    {
+      priv->prefetch_idle = 0;
+      return G_SOURCE_REMOVE;
+    }
 
-  gtk_text_layout_validate (text_view->priv->layout, 2000);
+  top = priv->yoffset;
+  height = SCREEN_HEIGHT (text_view);
+  deadline = g_get_monotonic_time () + INCREMENTAL_VALIDATE_BUDGET;
 
-  gtk_text_view_update_adjustments (text_view);
+  if (!gtk_text_layout_prefetch (priv->layout, top + height, top + height + height / 2, deadline) ||
+      !gtk_text_layout_prefetch (priv->layout, top - height / 2, top, deadline))
+    return G_SOURCE_CONTINUE;
+
+  priv->prefetch_idle = 0;
+  return G_SOURCE_REMOVE;
+}
+
+static void
+gtk_text_view_queue_prefetch (GtkTextView *text_view)
+{
+  GtkTextViewPrivate *priv = text_view->priv;
 
-  if (gtk_text_layout_is_valid (text_view->priv->layout))
+  if (priv->prefetch_idle == 0)
     {
-      text_view->priv->incremental_validate_idle = 0;
-      result = FALSE;
+      priv->prefetch_idle = g_idle_add_full (GTK_TEXT_VIEW_PRIORITY_VALIDATE + 1, prefetch_callback, text_view, NULL);
+      gdk_source_set_static_name_by_id (priv->prefetch_idle, "[gtk] prefetch_callback");
     }
+}
+
+/* Returns TRUE when the whole layout is valid */
+static gboolean
+gtk_text_view_validate_until (GtkTextView *text_view,
+                              gint64       deadline)
+{
+  DV(g_print(G_STRLOC"\n"));
+
+  do
+    gtk_text_layout_validate (text_view->priv->layout, 2000);
+  while (!gtk_text_layout_is_valid (text_view->priv->layout) &&
+         g_get_monotonic_time () < deadline);
+
+  gtk_text_view_update_adjustments (text_view);
 
-  return result;
+  if (!gtk_text_layout_is_valid (text_view->priv->layout))
+    return FALSE;
+
+  gtk_text_view_queue_prefetch (text_view);
+
+  return TRUE;
+}
+
+static gboolean
+incremental_validate_callback (gpointer data)
+{
+  GtkTextView *text_view = data;
+
+  if (!gtk_text_view_validate_until (text_view, g_get_monotonic_time () + INCREMENTAL_VALIDATE_BUDGET))
+    return G_SOURCE_CONTINUE;
+
+  text_view->priv->incremental_validate_idle = 0;
+  return G_SOURCE_REMOVE;
+}
+
+static gboolean
+incremental_validate_work (GdkFrameClock *frame_clock,
+                           gint64         deadline,
+                           gpointer       data)
+{
+  GtkTextView *text_view = data;
+  GtkTextViewPrivate *priv = text_view->priv;
+
+  if (!gtk_text_view_validate_until (text_view, deadline))
+    return G_SOURCE_CONTINUE;
+
+  priv->incremental_validate_work = 0;
+  g_clear_object (&priv->validate_frame_clock);
+  return G_SOURCE_REMOVE;
 }
 
 static void
@@ -5126,12 +5221,27 @@ gtk_text_view_invalidate (GtkTextView *text_view)
                    priv->first_validate_idle));
     }
 
-  if (!priv->incremental_validate_idle)
+  if (!priv->incremental_validate_idle && !priv->incremental_validate_work)
     {
-      priv->incremental_validate_idle = g_idle_add_full (GTK_TEXT_VIEW_PRIORITY_VALIDATE, incremental_validate_callback, text_view, NULL);
-      gdk_source_set_static_name_by_id (priv->incremental_validate_idle, "[gtk] incremental_validate_callback");
-      DV (g_print (G_STRLOC": adding incremental validate idle %d\n",
-                   priv->incremental_validate_idle));
+      GdkFrameClock *frame_clock = gtk_widget_get_frame_clock (GTK_WIDGET (text_view));
+
+      /* Once we are on screen, validate in the time that frames leave
+       * over, so that validation doesn't delay the next frame.
+       */
+      if (frame_clock)
+        {
+          priv->validate_frame_clock = g_object_ref (frame_clock);
+          priv->incremental_validate_work = gdk_frame_clock_add_work (frame_clock, incremental_validate_work, text_view, NULL);
+          DV (g_print (G_STRLOC": adding incremental validate work %d\n",
+                       priv->incremental_validate_work));
+        }
+      else
+        {
+          priv->incremental_validate_idle = g_idle_add_full (GTK_TEXT_VIEW_PRIORITY_VALIDATE, incremental_validate_callback, text_view, NULL);
+          gdk_source_set_static_name_by_id (priv->incremental_validate_idle, "[gtk] incremental_validate_callback");
+          DV (g_print (G_STRLOC": adding incremental validate idle %d\n",
+                       priv->incremental_validate_idle));
+        }
     }
 }
 
@@ -8775,6 +8885,8 @@ gtk_text_view_value_changed (GtkAdjustment *adjustment,
           gtk_text_buffer_move_mark (get_buffer (text_view), priv->first_para_mark, &iter);
 
           priv->first_para_pixels = value - line_top;
+
+          gtk_text_view_queue_prefetch (text_view);
         }
     }
 
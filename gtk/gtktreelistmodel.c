@@ -40,6 +40,11 @@ enum {
   NUM_PROPERTIES
 };
 
+/* Upper bound on the number of child models that are kept around
+ * for rows that are not expanded.
+ */
+#define MAX_PREFETCHED_MODELS 256
+
 typedef struct _TreeNode TreeNode;
 typedef struct _TreeAugment TreeAugment;
 
@@ -47,6 +52,8 @@ struct _TreeNode
 {
   gpointer item;
   GListModel *model;
+  GListModel *prefetched; /* created but not expanded yet */
+  GList *prefetch_link; /* in the model's prefetch_queue */
   GtkTreeListRow *row;
   GtkRbTree *children;
   union {
@@ -74,6 +81,9 @@ struct _GtkTreeListModel
   gpointer user_data;
   GDestroyNotify user_destroy;
 
+  /* GtkTreeListRow of nodes with prefetched models, oldest first */
+  GQueue prefetch_queue;
+
   guint autoexpand : 1;
   guint passthrough : 1;
 };
@@ -277,12 +287,40 @@ gtk_tree_list_model_get_nth (GtkTreeListModel *self,
   g_return_val_if_reached (NULL);
 }
 
+static GtkTreeListRow *
+tree_node_get_row (TreeNode *node)
+{
+  if (node->row)
+    {
+      return g_object_ref (node->row);
+    }
+  else
+    {
+      node->row = g_object_new (GTK_TYPE_TREE_LIST_ROW, NULL);
+      node->row->node = node;
+      node->row->item = g_object_ref (node->item);
+
+      return node->row;
+    }
+}
+
 static GListModel *
 tree_node_create_model (GtkTreeListModel *self,
                         TreeNode         *node)
 {
   GListModel *model;
 
+  if (node->prefetched)
+    {
+      GtkTreeListRow *row = node->prefetch_link->data;
+
+      g_queue_delete_link (&self->prefetch_queue, node->prefetch_link);
+      node->prefetch_link = NULL;
+      g_object_unref (row);
+
+      return g_steal_pointer (&node->prefetched);
+    }
+
   model = self->create_func (node->item, self->user_data);
   if (model == NULL)
     node->empty = TRUE;
@@ -290,21 +328,38 @@ tree_node_create_model (GtkTreeListModel *self,
   return model;
 }
 
-static GtkTreeListRow *
-tree_node_get_row (TreeNode *node)
+static void
+gtk_tree_list_model_prefetch_node (GtkTreeListModel *self,
+                                   TreeNode         *node)
 {
-  if (node->row)
+  GtkTreeListRow *row;
+
+  if (node->empty || node->model || node->prefetched)
+    return;
+
+  node->prefetched = self->create_func (node->item, self->user_data);
+  if (node->prefetched == NULL)
     {
-      return g_object_ref (node->row);
+      node->empty = TRUE;
+      return;
     }
-  else
-    {
-      node->row = g_object_new (GTK_TYPE_TREE_LIST_ROW, NULL);
-      node->row->node = node;
-      node->row->item = g_object_ref (node->item);
 
-      return node->row;
+  /* Rows of nodes that went away in the meantime just get dropped
+   * here, their model was freed together with the node.
+   */
+  while (g_queue_get_length (&self->prefetch_queue) >= MAX_PREFETCHED_MODELS)
+    {
+      row = g_queue_pop_head (&self->prefetch_queue);
+      if (row->node)
+        {
+          g_clear_object (&row->node->prefetched);
+          row->node->prefetch_link = NULL;
+        }
+      g_object_unref (row);
     }
+
+  g_queue_push_tail (&self->prefetch_queue, tree_node_get_row (node));
+  node->prefetch_link = self->prefetch_queue.tail;
 }
 
 static guint
@@ -395,6 +450,22 @@ gtk_tree_list_model_items_changed_cb (GListModel *model,
 
 static void gtk_tree_list_row_destroy (GtkTreeListRow *row);
 
+static void
+gtk_tree_list_model_clear_prefetch_queue (GtkTreeListModel *self)
+{
+  GtkTreeListRow *row;
+
+  while ((row = g_queue_pop_head (&self->prefetch_queue)))
+    {
+      if (row->node)
+        {
+          g_clear_object (&row->node->prefetched);
+          row->node->prefetch_link = NULL;
+        }
+      g_object_unref (row);
+    }
+}
+
 static void
 gtk_tree_list_model_clear_node_children (TreeNode *node)
 {
@@ -421,6 +492,9 @@ gtk_tree_list_model_clear_node (gpointer data)
     }
 
   gtk_tree_list_model_clear_node_children (node);
+  g_clear_object (&node->prefetched);
+  /* The queue entry keeps the destroyed row and is dropped later */
+  node->prefetch_link = NULL;
 
   if (node->row)
     g_object_thaw_notify (G_OBJECT (node->row));
@@ -646,6 +720,7 @@ gtk_tree_list_model_finalize (GObject *object)
 {
   GtkTreeListModel *self = GTK_TREE_LIST_MODEL (object);
 
+  gtk_tree_list_model_clear_prefetch_queue (self);
   gtk_tree_list_model_clear_node (&self->root_node);
   if (self->user_destroy)
     self->user_destroy (self->user_data);
@@ -728,6 +803,7 @@ gtk_tree_list_model_init (GtkTreeListModel *self)
 {
   self->root_node.list = self;
   self->root_node.is_root = TRUE;
+  g_queue_init (&self->prefetch_queue);
 }
 
 /**
@@ -928,6 +1004,50 @@ gtk_tree_list_model_get_child_row (GtkTreeListModel *self,
   return tree_node_get_row (child);
 }
 
+/**
+ * gtk_tree_list_model_prefetch:
+ * @self: a `GtkTreeListModel`
+ * @position: position of the first row to prefetch
+ * @n_items: number of rows to prefetch
+ *
+ * Creates the child models for the collapsed rows in the given range
+ * without expanding them.
+ *
+ * This is meant to be called for rows that are about to become visible,
+ * so that a [callback@Gtk.TreeListModelCreateModelFunc] that returns an
+ * initially empty model and fills it asynchronously can start loading
+ * before the row is expanded. Expanding a prefetched row then reuses
+ * the model instead of calling the function again.
+ *
+ * Only a limited number of prefetched models are kept. When that limit
+ * is reached, the oldest ones are released. Prefetched models of rows
+ * that are removed, or whose parent row is collapsed, are released too.
+ *
+ * Since: 4.22
+ */
+void
+gtk_tree_list_model_prefetch (GtkTreeListModel *self,
+                              guint             position,
+                              guint             n_items)
+{
+  TreeNode *node;
+  guint i, n;
+
+  g_return_if_fail (GTK_IS_TREE_LIST_MODEL (self));
+
+  n = tree_node_get_n_children (&self->root_node);
+  if (position >= n)
+    return;
+
+  n_items = MIN (n_items, MIN (n - position, MAX_PREFETCHED_MODELS));
+
+  for (i = 0; i < n_items; i++)
+    {
+      node = gtk_tree_list_model_get_nth (self, position + i);
+      gtk_tree_list_model_prefetch_node (self, node);
+    }
+}
+
 /**
  * GtkTreeListRow:
  *
@@ -1255,7 +1375,6 @@ gboolean
 gtk_tree_list_row_is_expandable (GtkTreeListRow *self)
 {
   GtkTreeListModel *list;
-  GListModel *model;
 
   g_return_val_if_fail (GTK_IS_TREE_LIST_ROW (self), FALSE);
 
@@ -1265,21 +1384,19 @@ gtk_tree_list_row_is_expandable (GtkTreeListRow *self)
   if (self->node->empty)
     return FALSE;
 
-  if (self->node->model)
+  if (self->node->model || self->node->prefetched)
     return TRUE;
 
   list = tree_node_get_tree_list_model (self->node);
   if (list == NULL)
     return FALSE;
 
-  model = tree_node_create_model (list, self->node);
-  if (model)
-    {
-      g_object_unref (model);
-      return TRUE;
-    }
+  /* Rows are usually asked this when they get bound to a widget,
+   * so keep the model around for the likely expansion.
+   */
+  gtk_tree_list_model_prefetch_node (list, self->node);
 
-  return FALSE;
+  return self->node->prefetched != NULL;
 }
 
 /**
@@ -80,6 +80,10 @@ GtkTreeListRow *        gtk_tree_list_model_get_child_row       (GtkTreeListMode
 GDK_AVAILABLE_IN_ALL
 GtkTreeListRow *        gtk_tree_list_model_get_row             (GtkTreeListModel       *self,
                                                                  guint                   position);
+GDK_AVAILABLE_IN_4_22
+void                    gtk_tree_list_model_prefetch            (GtkTreeListModel       *self,
+                                                                 guint                   position,
+                                                                 guint                   n_items);
 
 GDK_AVAILABLE_IN_ALL
 gpointer                gtk_tree_list_row_get_item              (GtkTreeListRow         *self);
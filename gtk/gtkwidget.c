@@ -652,6 +652,9 @@ static guint            widget_signals[LAST_SIGNAL] = { 0 };
 static GParamSpec      *widget_props[NUM_PROPERTIES] = { NULL, };
 GtkTextDirection        gtk_default_direction = GTK_TEXT_DIR_LTR;
 
+static guint            occluded_widgets_counter;
+static guint            n_occluded_widgets;
+
 static GQuark           quark_pango_context = 0;
 static GQuark           quark_mnemonic_labels = 0;
 static GQuark           quark_size_groups = 0;
@@ -735,6 +738,7 @@ gtk_widget_base_class_init (gpointer g_class)
   priv = klass->priv = G_TYPE_CLASS_GET_PRIVATE (g_class, GTK_TYPE_WIDGET, GtkWidgetClassPrivate);
 
   priv->template = NULL;
+  priv->timings = NULL;
 
   if (priv->shortcuts == NULL)
     {
@@ -761,7 +765,7 @@ gtk_widget_real_snapshot (GtkWidget   *widget,
 {
   GtkWidget *child;
 
-  for (child = _gtk_widget_get_first_child (widget);
+  for (child = gtk_widget_get_first_unoccluded_child (widget, NULL);
        child != NULL;
        child = _gtk_widget_get_next_sibling (child))
     gtk_widget_snapshot_child (widget, child, snapshot);
@@ -1193,6 +1197,9 @@ gtk_widget_class_init (GtkWidgetClass *klass)
   g_type_class_adjust_private_offset (klass, &GtkWidget_private_offset);
   gtk_widget_parent_class = g_type_class_peek_parent (klass);
 
+  occluded_widgets_counter = gdk_profiler_define_int_counter ("occluded-widgets",
+                                                              "Widgets not snapshotted because they were covered");
+
   quark_pango_context = g_quark_from_static_string ("gtk-pango-context");
   quark_mnemonic_labels = g_quark_from_static_string ("gtk-mnemonic-labels");
   quark_size_groups = g_quark_from_static_string ("gtk-widget-size-groups");
@@ -2842,6 +2849,7 @@ gtk_widget_real_hide (GtkWidget *widget)
     gtk_widget_unmap (widget);
 
   g_clear_pointer (&priv->allocated_transform, gsk_transform_unref);
+  priv->allocation_valid = FALSE;
   priv->allocated_width = 0;
   priv->allocated_height = 0;
   priv->allocated_baseline = 0;
@@ -3561,6 +3569,7 @@ gtk_widget_queue_draw (GtkWidget *widget)
 
       priv->draw_needed = TRUE;
       g_clear_pointer (&priv->render_node, gsk_render_node_unref);
+      g_clear_pointer (&priv->transform_node, gsk_render_node_unref);
       if (GTK_IS_NATIVE (w) && _gtk_widget_get_realized (w))
         gdk_surface_queue_render (gtk_native_get_surface (GTK_NATIVE (w)));
     }
@@ -4143,6 +4152,26 @@ gtk_widget_allocate (GtkWidget    *widget,
     }
 #endif /* G_ENABLE_DEBUG */
 
+  /* If neither the widget nor the arguments changed since the last
+   * allocation, there is nothing to recompute for this widget, and
+   * only children that queued an allocation themselves need one.
+   */
+  if (priv->allocation_valid &&
+      !priv->alloc_needed &&
+      priv->allocated_width == width &&
+      priv->allocated_height == height &&
+      priv->allocated_baseline == baseline &&
+      gsk_transform_equal (priv->allocated_transform, transform))
+    {
+      gsk_transform_unref (transform);
+
+      if (priv->surface_transform_data)
+        sync_widget_surface_transform (widget);
+
+      gtk_widget_ensure_allocate_on_children (widget);
+      goto out;
+    }
+
   alloc_needed = priv->alloc_needed;
   /* Preserve request/allocate ordering */
   priv->alloc_needed = FALSE;
@@ -4218,6 +4247,7 @@ gtk_widget_allocate (GtkWidget    *widget,
 
   gsk_transform_unref (priv->transform);
   priv->transform = transform;
+  priv->allocation_valid = TRUE;
 
   if (priv->surface_transform_data)
     sync_widget_surface_transform (widget);
@@ -4236,12 +4266,16 @@ gtk_widget_allocate (GtkWidget    *widget,
     }
   else
     {
+      GtkWidgetProfilerSpan span;
+
       priv->width = adjusted.width;
       priv->height = adjusted.height;
       priv->baseline = baseline;
 
       priv->alloc_needed_on_child = FALSE;
 
+      gtk_widget_profiler_begin (&span);
+
       if (priv->layout_manager != NULL)
         {
           gtk_layout_manager_allocate (priv->layout_manager, widget,
@@ -4257,6 +4291,8 @@ gtk_widget_allocate (GtkWidget    *widget,
                                                         baseline);
         }
 
+      gtk_widget_profiler_end (&span, widget, GTK_WIDGET_PHASE_ALLOCATE);
+
       /* Size allocation is god... after consulting god, no further requests or allocations are needed */
       if (GTK_DISPLAY_DEBUG_CHECK (_gtk_widget_get_display (widget), GEOMETRY) &&
           gtk_widget_get_resize_queued (widget))
@@ -5145,6 +5181,7 @@ gtk_widget_real_css_changed (GtkWidget         *widget,
           else if (gtk_css_style_change_affects (change, GTK_CSS_AFFECTS_TRANSFORM) &&
                    priv->parent)
             {
+              priv->allocation_valid = FALSE;
               gtk_widget_queue_allocate (priv->parent);
             }
 
@@ -5891,6 +5928,7 @@ _gtk_widget_set_visible_flag (GtkWidget *widget,
   if (!visible)
     {
       g_clear_pointer (&priv->allocated_transform, gsk_transform_unref);
+      priv->allocation_valid = FALSE;
       priv->allocated_width = 0;
       priv->allocated_height = 0;
       priv->allocated_baseline = 0;
@@ -7378,11 +7416,13 @@ static void
 gtk_widget_emit_direction_changed (GtkWidget        *widget,
                                    GtkTextDirection  old_dir)
 {
+  GtkWidgetPrivate *priv = gtk_widget_get_instance_private (widget);
   GtkTextDirection direction;
   GtkStateFlags state;
 
   gtk_widget_update_default_pango_context (widget);
 
+  priv->allocation_valid = FALSE;
   direction = _gtk_widget_get_direction (widget);
 
   switch (direction)
@@ -7772,6 +7812,7 @@ gtk_widget_finalize (GObject *object)
 
   g_clear_pointer (&priv->transform, gsk_transform_unref);
   g_clear_pointer (&priv->allocated_transform, gsk_transform_unref);
+  g_clear_pointer (&priv->transform_node, gsk_render_node_unref);
 
   gtk_css_widget_node_widget_destroyed (GTK_CSS_WIDGET_NODE (priv->cssnode));
   g_object_unref (priv->cssnode);
@@ -12009,6 +12050,7 @@ gtk_widget_do_snapshot (GtkWidget   *widget,
 {
   GtkWidgetPrivate *priv = gtk_widget_get_instance_private (widget);
   GskRenderNode *render_node;
+  GtkWidgetProfilerSpan span;
 
   if (!priv->draw_needed)
     return;
@@ -12023,7 +12065,9 @@ gtk_widget_do_snapshot (GtkWidget   *widget,
 
   gtk_widget_push_paintables (widget);
 
+  gtk_widget_profiler_begin (&span);
   render_node = gtk_widget_create_render_node (widget, snapshot);
+  gtk_widget_profiler_end (&span, widget, GTK_WIDGET_PHASE_SNAPSHOT);
   /* This can happen when nested drawing happens and a widget contains itself
    * or when we replace a clipped area
    */
@@ -12094,7 +12138,9 @@ gtk_widget_render (GtkWidget            *widget,
     {
       before_render = GDK_PROFILER_CURRENT_TIME;
       gdk_profiler_add_mark (before_snapshot, (before_render - before_snapshot), "Widget snapshot", "");
+      gdk_profiler_set_int_counter (occluded_widgets_counter, n_occluded_widgets);
     }
+  n_occluded_widgets = 0;
 
   if (root != NULL)
     {
@@ -12111,6 +12157,9 @@ gtk_widget_render (GtkWidget            *widget,
 
       gdk_profiler_end_mark (before_render, "Widget render", "");
     }
+
+  if (gtk_widget_profiler_is_running ())
+    gtk_widget_profiler_watch_frame_clock (gtk_widget_get_frame_clock (widget));
 }
 
 static void
@@ -12422,6 +12471,146 @@ gtk_widget_forall (GtkWidget   *widget,
     }
 }
 
+/* Gets the area that @child opaquely covers in the coordinates of
+ * its parent, from the render node of its last snapshot */
+static gboolean
+gtk_widget_get_opaque_child_rect (GtkWidget       *child,
+                                  graphene_rect_t *opaque)
+{
+  GtkWidgetPrivate *priv = gtk_widget_get_instance_private (child);
+
+  if (!priv->mapped ||
+      priv->draw_needed ||
+      priv->render_node == NULL ||
+      GTK_IS_NATIVE (child))
+    return FALSE;
+
+  if (!gsk_render_node_get_opaque_rect (priv->render_node, opaque))
+    return FALSE;
+
+  if (priv->transform)
+    {
+      if (gsk_transform_get_category (priv->transform) < GSK_TRANSFORM_CATEGORY_2D_AFFINE)
+        return FALSE;
+
+      gsk_transform_transform_bounds (priv->transform, opaque, opaque);
+    }
+
+  return TRUE;
+}
+
+/* Checks if everything @child draws lies inside @opaque. What it
+ * draws is taken from the render node of its last snapshot, and its
+ * border box in case it was resized since then. */
+static gboolean
+gtk_widget_child_is_inside (GtkWidget             *child,
+                            const graphene_rect_t *opaque)
+{
+  GtkWidgetPrivate *priv = gtk_widget_get_instance_private (child);
+  GtkCssBoxes boxes;
+  graphene_rect_t bounds;
+
+  /* Not drawn by the parent at all */
+  if (!priv->mapped || GTK_IS_NATIVE (child))
+    return TRUE;
+
+  if (priv->render_node == NULL)
+    return FALSE;
+
+  gtk_css_boxes_init (&boxes, child);
+  gsk_render_node_get_bounds (priv->render_node, &bounds);
+  graphene_rect_union (&bounds, gtk_css_boxes_get_border_rect (&boxes), &bounds);
+
+  if (priv->transform)
+    {
+      if (gsk_transform_get_category (priv->transform) < GSK_TRANSFORM_CATEGORY_2D)
+        return FALSE;
+
+      gsk_transform_transform_bounds (priv->transform, &bounds, &bounds);
+    }
+
+  return graphene_rect_contains_rect (opaque, &bounds);
+}
+
+/*
+ * gtk_widget_get_first_unoccluded_child:
+ * @widget: a `GtkWidget`
+ * @can_cover: (nullable): function to exclude children from covering
+ *   their siblings
+ *
+ * Finds the first child of @widget that can be visible when the
+ * children are snapshotted in order, so that snapshotting can start
+ * from it.
+ *
+ * The children before it are hidden below a later sibling. Either
+ * that sibling opaquely covers the area @widget clips its children to,
+ * when @widget has hidden overflow, or the children were drawn inside
+ * the opaque area of the sibling the last time they were snapshotted
+ * and still fit into it.
+ *
+ * The opaque area of a sibling is taken from its render node, so
+ * only siblings that don't need to be redrawn can cover others.
+ * Widgets that clip some of their children when drawing them can
+ * pass @can_cover to exclude those.
+ *
+ * Returns: (nullable): the first child to snapshot
+ */
+GtkWidget *
+gtk_widget_get_first_unoccluded_child (GtkWidget          *widget,
+                                       GtkWidgetCoverFunc  can_cover)
+{
+  GtkWidgetPrivate *priv = gtk_widget_get_instance_private (widget);
+  GtkWidget *first, *result, *child, *occluded;
+  GtkCssBoxes boxes;
+  const graphene_rect_t *area = NULL;
+  graphene_rect_t opaque;
+
+  first = _gtk_widget_get_first_child (widget);
+  if (first == NULL ||
+      first == _gtk_widget_get_last_child (widget))
+    return first;
+
+  if (priv->overflow == GTK_OVERFLOW_HIDDEN)
+    {
+      gtk_css_boxes_init (&boxes, widget);
+      area = gtk_css_boxes_get_padding_rect (&boxes);
+    }
+
+  result = first;
+  for (child = _gtk_widget_get_last_child (widget);
+       child != result;
+       child = _gtk_widget_get_prev_sibling (child))
+    {
+      if (can_cover != NULL && !can_cover (widget, child))
+        continue;
+
+      if (!gtk_widget_get_opaque_child_rect (child, &opaque))
+        continue;
+
+      if (area != NULL && graphene_rect_contains_rect (&opaque, area))
+        {
+          result = child;
+          break;
+        }
+
+      /* Children before result are already known to be covered */
+      for (occluded = result;
+           occluded != child && gtk_widget_child_is_inside (occluded, &opaque);
+           occluded = _gtk_widget_get_next_sibling (occluded))
+        ;
+
+      result = occluded;
+    }
+
+  for (occluded = first; occluded != result; occluded = _gtk_widget_get_next_sibling (occluded))
+    {
+      if (_gtk_widget_get_mapped (occluded))
+        n_occluded_widgets++;
+    }
+
+  return result;
+}
+
 /**
  * gtk_widget_snapshot_child:
  * @widget: a widget
@@ -12468,11 +12657,20 @@ gtk_widget_snapshot_child (GtkWidget   *widget,
 
   if (priv->transform)
     {
-      GskRenderNode *transform_node = gsk_transform_node_new (priv->render_node,
-                                                              priv->transform);
+      /* Reuse the node from the last time if nothing changed, so that
+       * diffing the parent's node can skip this child right away.
+       */
+      if (priv->transform_node == NULL ||
+          gsk_transform_node_get_child (priv->transform_node) != priv->render_node ||
+          !gsk_transform_equal (gsk_transform_node_get_transform (priv->transform_node),
+                                priv->transform))
+        {
+          g_clear_pointer (&priv->transform_node, gsk_render_node_unref);
+          priv->transform_node = gsk_transform_node_new (priv->render_node,
+                                                         priv->transform);
+        }
 
-      gtk_snapshot_append_node (snapshot, transform_node);
-      gsk_render_node_unref (transform_node);
+      gtk_snapshot_append_node (snapshot, priv->transform_node);
     }
   else
     {
@@ -34,6 +34,7 @@
 #include "gtklistlistmodelprivate.h"
 #include "gtkrootprivate.h"
 #include "gtksizerequestcacheprivate.h"
+#include "gtkwidgetprofilerprivate.h"
 #include "gtkwindowprivate.h"
 #include "gtkgesture.h"
 
@@ -41,6 +42,9 @@
 
 G_BEGIN_DECLS
 
+typedef gboolean (*GtkWidgetCoverFunc) (GtkWidget *widget,
+                                        GtkWidget *child);
+
 typedef gboolean (*GtkSurfaceTransformChangedCallback) (GtkWidget               *widget,
                                                         const graphene_matrix_t *surface_transform,
                                                         gpointer                 user_data);
@@ -87,6 +91,7 @@ struct _GtkWidgetPrivate
   guint resize_queued         : 1; /* queue_resize() has been called but no get_preferred_size() yet */
   guint alloc_needed          : 1; /* this widget needs a size_allocate() call */
   guint alloc_needed_on_child : 1; /* 0 or more children - or this widget - need a size_allocate() call */
+  guint allocation_valid      : 1; /* transform and size match the last gtk_widget_allocate() arguments */
 
   /* Queue-draw related flags */
   guint draw_needed           : 1;
@@ -167,6 +172,11 @@ struct _GtkWidgetPrivate
 
   /* The render node we draw or %NULL if not yet created.*/
   GskRenderNode *render_node;
+  /* render_node wrapped in transform, as appended by the parent.
+   * Kept so that the parent's node refers to the same node for
+   * as long as this widget stays unchanged.
+   */
+  GskRenderNode *transform_node;
 
   /* The layout manager, or %NULL */
   GtkLayoutManager *layout_manager;
@@ -217,6 +227,15 @@ struct _GtkWidgetClassPrivate
   GtkAccessibleRole accessible_role;
   guint activate_signal;
   GQuark css_name;
+
+  /* Returns the layout whose size measure() will look up for
+   * @for_size, if measuring it can be done on another thread */
+  PangoLayout * (* get_measuring_layout) (GtkWidget      *widget,
+                                          GtkOrientation  orientation,
+                                          int             for_size);
+
+  /* Allocated when the class is first profiled */
+  GtkWidgetClassTimings *timings;
 };
 
 void          gtk_widget_root               (GtkWidget *widget);
@@ -228,6 +247,13 @@ gboolean     _gtk_widget_get_alloc_needed   (GtkWidget *widget);
 gboolean     gtk_widget_needs_allocate      (GtkWidget *widget);
 void         gtk_widget_clear_resize_queued (GtkWidget *widget);
 void         gtk_widget_ensure_allocate     (GtkWidget *widget);
+GtkWidget *  gtk_widget_get_first_unoccluded_child (GtkWidget          *widget,
+                                                    GtkWidgetCoverFunc  can_cover);
+gboolean     gtk_widget_can_prefetch_measure (void);
+void         gtk_widget_prefetch_measure    (GtkWidget      **widgets,
+                                             const int       *for_sizes,
+                                             guint            n_widgets,
+                                             GtkOrientation   orientation);
 void          _gtk_widget_scale_changed     (GtkWidget *widget);
 void         gtk_widget_monitor_changed     (GtkWidget *widget);
 
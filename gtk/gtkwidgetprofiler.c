@@ -0,0 +1,317 @@
+/*
+ * Copyright © 2025 the GTK team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+
+#include "gtkwidgetprofilerprivate.h"
+
+#include "gtkwidgetprivate.h"
+#include "gdk/gdkprofilerprivate.h"
+
+#include <string.h>
+
+/* Aggregates the time spent in measure, size_allocate, snapshot and
+ * CSS validation per widget class.
+ *
+ * The spans nest the same way the widget tree is traversed, so every
+ * span keeps track of the time its children took and only the
+ * remainder is attributed to the widget's class. The timings live in
+ * the class private struct and are collected into a summary for the
+ * frame clock once it has painted a frame, so a window and the popovers
+ * that share its frame clock are summarized together.
+ */
+
+#define N_MARKED_CLASSES 5
+
+static guint n_users;
+static gint64 child_time;
+static gint64 frame_start;
+static guint frame = 1;
+/* GtkWidgetClassTimings, the classes that were active in this frame */
+static GPtrArray *frame_timings;
+static guint phase_counters[GTK_WIDGET_N_PHASES];
+
+static const char *phase_names[GTK_WIDGET_N_PHASES] = {
+  [GTK_WIDGET_PHASE_MEASURE] = "measure",
+  [GTK_WIDGET_PHASE_ALLOCATE] = "allocate",
+  [GTK_WIDGET_PHASE_SNAPSHOT] = "snapshot",
+  [GTK_WIDGET_PHASE_CSS] = "css",
+};
+
+static inline gint64
+current_time (void)
+{
+#ifdef HAVE_SYSPROF
+  return SYSPROF_CAPTURE_CURRENT_TIME;
+#else
+  return g_get_monotonic_time () * 1000;
+#endif
+}
+
+const char *
+gtk_widget_phase_get_name (GtkWidgetPhase phase)
+{
+  return phase_names[phase];
+}
+
+/*
+ * gtk_widget_profiler_is_running:
+ *
+ * Returns whether widget timings are collected, either because
+ * sysprof is recording or because the inspector shows them.
+ *
+ * Returns: %TRUE if widget timings are collected
+ */
+gboolean
+gtk_widget_profiler_is_running (void)
+{
+  return n_users > 0 || GDK_PROFILER_IS_RUNNING;
+}
+
+void
+gtk_widget_profiler_start (void)
+{
+  n_users++;
+}
+
+void
+gtk_widget_profiler_stop (void)
+{
+  g_return_if_fail (n_users > 0);
+
+  n_users--;
+}
+
+void
+gtk_widget_profiler_begin (GtkWidgetProfilerSpan *span)
+{
+  if (!gtk_widget_profiler_is_running ())
+    {
+      span->start = 0;
+      return;
+    }
+
+  span->start = current_time ();
+  span->child_time = child_time;
+  child_time = 0;
+
+  if (frame_start == 0)
+    frame_start = span->start;
+}
+
+static GtkWidgetClassTimings *
+get_class_timings (GtkWidget *widget)
+{
+  GtkWidgetClassPrivate *class_priv = GTK_WIDGET_GET_CLASS (widget)->priv;
+  GtkWidgetClassTimings *timings;
+
+  if (class_priv->timings == NULL)
+    {
+      class_priv->timings = g_new0 (GtkWidgetClassTimings, 1);
+      class_priv->timings->type = G_OBJECT_TYPE (widget);
+    }
+
+  timings = class_priv->timings;
+  if (timings->frame != frame)
+    {
+      memset (timings->time, 0, sizeof (timings->time));
+      memset (timings->count, 0, sizeof (timings->count));
+      timings->frame = frame;
+
+      if (frame_timings == NULL)
+        frame_timings = g_ptr_array_new ();
+      g_ptr_array_add (frame_timings, timings);
+    }
+
+  return timings;
+}
+
+void
+gtk_widget_profiler_end (GtkWidgetProfilerSpan *span,
+                         GtkWidget             *widget,
+                         GtkWidgetPhase         phase)
+{
+  GtkWidgetClassTimings *timings;
+  gint64 total;
+
+  if (span->start == 0)
+    return;
+
+  total = current_time () - span->start;
+
+  /* CSS nodes can outlive their widget */
+  if (widget != NULL)
+    {
+      timings = get_class_timings (widget);
+      timings->time[phase] += MAX (total - child_time, 0);
+      timings->count[phase]++;
+    }
+
+  child_time = span->child_time + total;
+}
+
+static gint64
+get_total_time (const GtkWidgetClassTimings *timings)
+{
+  gint64 total = 0;
+  guint i;
+
+  for (i = 0; i < GTK_WIDGET_N_PHASES; i++)
+    total += timings->time[i];
+
+  return total;
+}
+
+static int
+compare_timings (gconstpointer a,
+                 gconstpointer b)
+{
+  gint64 ta = get_total_time (a);
+  gint64 tb = get_total_time (b);
+
+  return ta < tb ? 1 : (ta > tb ? -1 : 0);
+}
+
+static void
+add_profiler_marks (GArray *last_frame)
+{
+  gint64 totals[GTK_WIDGET_N_PHASES] = { 0, };
+  GString *message;
+  guint i, j;
+
+  if (phase_counters[0] == 0)
+    {
+      phase_counters[GTK_WIDGET_PHASE_MEASURE] =
+          gdk_profiler_define_counter ("widget-measure-time", "Time spent in measure (ms)");
+      phase_counters[GTK_WIDGET_PHASE_ALLOCATE] =
+          gdk_profiler_define_counter ("widget-allocate-time", "Time spent in size_allocate (ms)");
+      phase_counters[GTK_WIDGET_PHASE_SNAPSHOT] =
+          gdk_profiler_define_counter ("widget-snapshot-time", "Time spent in snapshot (ms)");
+      phase_counters[GTK_WIDGET_PHASE_CSS] =
+          gdk_profiler_define_counter ("widget-css-time", "Time spent validating CSS (ms)");
+    }
+
+  message = g_string_new (NULL);
+
+  for (i = 0; i < last_frame->len; i++)
+    {
+      const GtkWidgetClassTimings *timings = &g_array_index (last_frame, GtkWidgetClassTimings, i);
+
+      for (j = 0; j < GTK_WIDGET_N_PHASES; j++)
+        totals[j] += timings->time[j];
+
+      if (i < N_MARKED_CLASSES)
+        g_string_append_printf (message, "%s%s %.2f ms",
+                                i > 0 ? ", " : "",
+                                g_type_name (timings->type),
+                                get_total_time (timings) / 1000000.);
+    }
+
+  for (j = 0; j < GTK_WIDGET_N_PHASES; j++)
+    gdk_profiler_set_counter (phase_counters[j], totals[j] / 1000000.);
+
+  gdk_profiler_end_mark (frame_start, "Widget classes", message->str);
+
+  g_string_free (message, TRUE);
+}
+
+/*
+ * gtk_widget_profiler_end_frame:
+ * @frame_clock: the frame clock that painted a frame
+ *
+ * Collects the timings of the classes that were active since the
+ * last call into the summary returned by
+ * gtk_widget_profiler_get_last_frame(), and reports them to sysprof.
+ */
+void
+gtk_widget_profiler_end_frame (GdkFrameClock *frame_clock)
+{
+  GArray *last_frame;
+  guint i;
+
+  if (frame_timings == NULL || frame_timings->len == 0)
+    return;
+
+  last_frame = g_array_sized_new (FALSE, FALSE, sizeof (GtkWidgetClassTimings), frame_timings->len);
+  for (i = 0; i < frame_timings->len; i++)
+    g_array_append_vals (last_frame, g_ptr_array_index (frame_timings, i), 1);
+  g_array_sort (last_frame, compare_timings);
+
+  if (GDK_PROFILER_IS_RUNNING)
+    add_profiler_marks (last_frame);
+
+  g_object_set_qdata_full (G_OBJECT (frame_clock),
+                           g_quark_from_static_string ("gtk-widget-profiler-last-frame"),
+                           last_frame,
+                           (GDestroyNotify) g_array_unref);
+
+  g_ptr_array_set_size (frame_timings, 0);
+  frame_start = 0;
+  frame++;
+}
+
+/*
+ * gtk_widget_profiler_watch_frame_clock:
+ * @frame_clock: the frame clock of a native widget that is rendering
+ *
+ * Makes sure that gtk_widget_profiler_end_frame() is called once all
+ * natives that use @frame_clock have been painted.
+ */
+void
+gtk_widget_profiler_watch_frame_clock (GdkFrameClock *frame_clock)
+{
+  GQuark quark = g_quark_from_static_string ("gtk-widget-profiler-watched");
+
+  if (g_object_get_qdata (G_OBJECT (frame_clock), quark))
+    return;
+
+  g_signal_connect (frame_clock, "after-paint",
+                    G_CALLBACK (gtk_widget_profiler_end_frame), NULL);
+  g_object_set_qdata (G_OBJECT (frame_clock), quark, GINT_TO_POINTER (TRUE));
+}
+
+/*
+ * gtk_widget_profiler_get_last_frame:
+ * @frame_clock: a frame clock
+ * @n_timings: (out): return location for the number of timings
+ *
+ * Gets the timings of the last frame that @frame_clock painted, sorted
+ * by the total time spent in each class, the most expensive first.
+ *
+ * The timings cover all natives that share @frame_clock. Work done
+ * outside of a frame, for example measuring widgets in an event
+ * handler, is counted towards the next frame that gets painted.
+ *
+ * Returns: (transfer none) (array length=n_timings): the timings
+ */
+const GtkWidgetClassTimings *
+gtk_widget_profiler_get_last_frame (GdkFrameClock *frame_clock,
+                                    guint         *n_timings)
+{
+  GArray *last_frame;
+
+  last_frame = g_object_get_qdata (G_OBJECT (frame_clock),
+                                   g_quark_from_static_string ("gtk-widget-profiler-last-frame"));
+  if (last_frame == NULL)
+    {
+      *n_timings = 0;
+      return NULL;
+    }
+
+  *n_timings = last_frame->len;
+  return (const GtkWidgetClassTimings *) last_frame->data;
+}
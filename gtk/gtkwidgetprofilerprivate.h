@@ -0,0 +1,73 @@
+/*
+ * Copyright © 2025 the GTK team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "gtkwidget.h"
+
+G_BEGIN_DECLS
+
+typedef enum {
+  GTK_WIDGET_PHASE_MEASURE,
+  GTK_WIDGET_PHASE_ALLOCATE,
+  GTK_WIDGET_PHASE_SNAPSHOT,
+  GTK_WIDGET_PHASE_CSS,
+  GTK_WIDGET_N_PHASES
+} GtkWidgetPhase;
+
+typedef struct _GtkWidgetClassTimings GtkWidgetClassTimings;
+typedef struct _GtkWidgetProfilerSpan GtkWidgetProfilerSpan;
+
+/* Time spent in the widgets of one class during a frame, not
+ * counting the time spent in their children. Times are in
+ * nanoseconds.
+ */
+struct _GtkWidgetClassTimings
+{
+  GType type;
+  gint64 time[GTK_WIDGET_N_PHASES];
+  guint count[GTK_WIDGET_N_PHASES];
+
+  /*< private >*/
+  guint frame;
+};
+
+struct _GtkWidgetProfilerSpan
+{
+  gint64 start;
+  gint64 child_time;
+};
+
+gboolean        gtk_widget_profiler_is_running          (void);
+void            gtk_widget_profiler_start               (void);
+void            gtk_widget_profiler_stop                (void);
+
+void            gtk_widget_profiler_begin               (GtkWidgetProfilerSpan  *span);
+void            gtk_widget_profiler_end                 (GtkWidgetProfilerSpan  *span,
+                                                         GtkWidget              *widget,
+                                                         GtkWidgetPhase          phase);
+
+void            gtk_widget_profiler_end_frame           (GdkFrameClock          *frame_clock);
+void            gtk_widget_profiler_watch_frame_clock   (GdkFrameClock          *frame_clock);
+
+const GtkWidgetClassTimings *
+                gtk_widget_profiler_get_last_frame      (GdkFrameClock          *frame_clock,
+                                                         guint                  *n_timings);
+
+const char *    gtk_widget_phase_get_name               (GtkWidgetPhase          phase);
+
+G_END_DECLS
@@ -33,6 +33,9 @@
 #include "gtkwidgetprivate.h"
 #include "gtkbinlayout.h"
 #include "gtkwidgetprivate.h"
+#include "gtktextviewprivate.h"
+#include "gtktextlinedisplaycacheprivate.h"
+#include "gtklistbaseprivate.h"
 #include "gdk/gdksurfaceprivate.h"
 
 struct _GtkInspectorMiscInfo
@@ -93,6 +96,10 @@ struct _GtkInspectorMiscInfo
   GtkWidget *is_toplevel;
   GtkWidget *child_visible_row;
   GtkWidget *child_visible;
+  GtkWidget *display_cache_row;
+  GtkWidget *display_cache;
+  GtkWidget *list_items_row;
+  GtkWidget *list_items;
 
   guint update_source_id;
   gint64 last_frame;
@@ -332,6 +339,42 @@ update_frame_clock (GtkInspectorMiscInfo *sl)
     }
 }
 
+static void
+update_display_cache (GtkInspectorMiscInfo *sl)
+{
+  GtkTextLayout *layout;
+  GtkTextLineDisplayCacheStats stats;
+  guint64 lookups;
+  char *tmp;
+
+  layout = gtk_text_view_get_layout (GTK_TEXT_VIEW (sl->object));
+  gtk_text_layout_get_display_cache_stats (layout, &stats);
+  lookups = stats.hits + stats.misses;
+
+  tmp = g_strdup_printf ("%u ⁄ %u lines, %.1f%% hits, %"G_GUINT64_FORMAT" invalidations",
+                         stats.size, stats.mru_size,
+                         lookups > 0 ? 100. * stats.hits / lookups : 0.,
+                         stats.inval);
+  gtk_label_set_label (GTK_LABEL (sl->display_cache), tmp);
+  g_free (tmp);
+}
+
+static void
+update_list_items (GtkInspectorMiscInfo *sl)
+{
+  guint n_created, n_recycled;
+  char *tmp;
+
+  gtk_list_item_manager_get_item_stats (gtk_list_base_get_manager (GTK_LIST_BASE (sl->object)),
+                                        &n_created, &n_recycled);
+
+  tmp = g_strdup_printf ("%u created, %u reused, %.1f%% from the pool",
+                         n_created, n_recycled,
+                         n_created + n_recycled > 0 ? 100. * n_recycled / (n_created + n_recycled) : 0.);
+  gtk_label_set_label (GTK_LABEL (sl->list_items), tmp);
+  g_free (tmp);
+}
+
 static void
 update_direction (GtkInspectorMiscInfo *sl)
 {
@@ -411,6 +454,12 @@ update_info (gpointer data)
       gtk_widget_set_visible (sl->child_visible, _gtk_widget_get_child_visible (GTK_WIDGET (sl->object)));
     }
 
+  if (GTK_IS_TEXT_VIEW (sl->object))
+    update_display_cache (sl);
+
+  if (GTK_IS_LIST_BASE (sl->object))
+    update_list_items (sl);
+
   update_surface (sl);
   update_renderer (sl);
   update_frame_clock (sl);
@@ -528,6 +577,8 @@ gtk_inspector_misc_info_set_object (GtkInspectorMiscInfo *sl,
   gtk_widget_set_visible (sl->realized_row, GTK_IS_WIDGET (object));
   gtk_widget_set_visible (sl->is_toplevel_row, GTK_IS_WIDGET (object));
   gtk_widget_set_visible (sl->child_visible_row, GTK_IS_WIDGET (object));
+  gtk_widget_set_visible (sl->display_cache_row, GTK_IS_TEXT_VIEW (object));
+  gtk_widget_set_visible (sl->list_items_row, GTK_IS_LIST_BASE (object));
   gtk_widget_set_visible (sl->frame_clock_row, GTK_IS_WIDGET (object));
   gtk_widget_set_visible (sl->buildable_id_row, GTK_IS_BUILDABLE (object));
   gtk_widget_set_visible (sl->framecount_row, GDK_IS_FRAME_CLOCK (object));
@@ -657,6 +708,10 @@ gtk_inspector_misc_info_class_init (GtkInspectorMiscInfoClass *klass)
   gtk_widget_class_bind_template_child (widget_class, GtkInspectorMiscInfo, is_toplevel);
   gtk_widget_class_bind_template_child (widget_class, GtkInspectorMiscInfo, child_visible_row);
   gtk_widget_class_bind_template_child (widget_class, GtkInspectorMiscInfo, child_visible);
+  gtk_widget_class_bind_template_child (widget_class, GtkInspectorMiscInfo, display_cache_row);
+  gtk_widget_class_bind_template_child (widget_class, GtkInspectorMiscInfo, display_cache);
+  gtk_widget_class_bind_template_child (widget_class, GtkInspectorMiscInfo, list_items_row);
+  gtk_widget_class_bind_template_child (widget_class, GtkInspectorMiscInfo, list_items);
 
   gtk_widget_class_bind_template_callback (widget_class, update_measure_picture);
   gtk_widget_class_bind_template_callback (widget_class, measure_picture_drag_prepare);
@@ -0,0 +1,164 @@
+/*
+ * Copyright © 2025 the GTK team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+
+#include "timingsoverlay.h"
+
+#include "gtkwidget.h"
+#include "gtkwindow.h"
+#include "gtknative.h"
+#include "gtkwidgetprofilerprivate.h"
+
+/* Number of widget classes to show */
+#define N_CLASSES 10
+
+struct _GtkTimingsOverlay
+{
+  GtkInspectorOverlay parent_instance;
+
+  gboolean running;
+};
+
+struct _GtkTimingsOverlayClass
+{
+  GtkInspectorOverlayClass parent_class;
+};
+
+G_DEFINE_TYPE (GtkTimingsOverlay, gtk_timings_overlay, GTK_TYPE_INSPECTOR_OVERLAY)
+
+static char *
+gtk_timings_overlay_format (GtkWidget *widget)
+{
+  const GtkWidgetClassTimings *timings;
+  GString *text;
+  guint i, j, n;
+
+  timings = gtk_widget_profiler_get_last_frame (gtk_widget_get_frame_clock (widget), &n);
+  if (n == 0)
+    return NULL;
+
+  text = g_string_new (NULL);
+  g_string_append_printf (text, "%-24s", "ms");
+  for (j = 0; j < GTK_WIDGET_N_PHASES; j++)
+    g_string_append_printf (text, " %9s", gtk_widget_phase_get_name (j));
+
+  for (i = 0; i < MIN (n, N_CLASSES); i++)
+    {
+      g_string_append_printf (text, "\n%-24.24s", g_type_name (timings[i].type));
+      for (j = 0; j < GTK_WIDGET_N_PHASES; j++)
+        g_string_append_printf (text, " %9.3f", timings[i].time[j] / 1000000.);
+    }
+
+  return g_string_free (text, FALSE);
+}
+
+static gboolean
+gtk_timings_overlay_force_redraw (GtkWidget     *widget,
+                                  GdkFrameClock *clock,
+                                  gpointer       unused)
+{
+  gdk_surface_queue_render (gtk_native_get_surface (gtk_widget_get_native (widget)));
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+gtk_timings_overlay_snapshot (GtkInspectorOverlay *overlay,
+                              GtkSnapshot         *snapshot,
+                              GskRenderNode       *node,
+                              GtkWidget           *widget)
+{
+  PangoLayout *layout;
+  PangoAttrList *attrs;
+  char *text;
+  int width, height;
+
+  if (!GTK_IS_WINDOW (widget))
+    return;
+
+  /* Keep the numbers current while nothing else redraws */
+  gtk_widget_add_tick_callback (widget, gtk_timings_overlay_force_redraw, NULL, NULL);
+
+  /* This shows the frame before the current one, the current
+   * frame isn't done until the frame clock has painted it. It
+   * includes the popovers of the window */
+  text = gtk_timings_overlay_format (widget);
+  if (text == NULL)
+    return;
+
+  layout = gtk_widget_create_pango_layout (widget, text);
+  attrs = pango_attr_list_new ();
+  pango_attr_list_insert (attrs, pango_attr_family_new ("Monospace"));
+  pango_attr_list_insert (attrs, pango_attr_font_features_new ("tnum=1"));
+  pango_layout_set_attributes (layout, attrs);
+  pango_attr_list_unref (attrs);
+  pango_layout_get_pixel_size (layout, &width, &height);
+
+  gtk_snapshot_append_color (snapshot,
+                             &(GdkRGBA) { 0, 0, 0, 0.5 },
+                             &GRAPHENE_RECT_INIT (0, 0, width + 8, height + 8));
+  gtk_snapshot_save (snapshot);
+  gtk_snapshot_translate (snapshot, &GRAPHENE_POINT_INIT (4, 4));
+  gtk_snapshot_append_layout (snapshot, layout, &(GdkRGBA) { 1, 1, 1, 1 });
+  gtk_snapshot_restore (snapshot);
+
+  g_object_unref (layout);
+  g_free (text);
+}
+
+static void
+gtk_timings_overlay_dispose (GObject *object)
+{
+  GtkTimingsOverlay *self = GTK_TIMINGS_OVERLAY (object);
+
+  if (self->running)
+    {
+      gtk_widget_profiler_stop ();
+      self->running = FALSE;
+    }
+
+  G_OBJECT_CLASS (gtk_timings_overlay_parent_class)->dispose (object);
+}
+
+static void
+gtk_timings_overlay_class_init (GtkTimingsOverlayClass *klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+  GtkInspectorOverlayClass *overlay_class = GTK_INSPECTOR_OVERLAY_CLASS (klass);
+
+  overlay_class->snapshot = gtk_timings_overlay_snapshot;
+
+  gobject_class->dispose = gtk_timings_overlay_dispose;
+}
+
+static void
+gtk_timings_overlay_init (GtkTimingsOverlay *self)
+{
+  gtk_widget_profiler_start ();
+  self->running = TRUE;
+}
+
+GtkInspectorOverlay *
+gtk_timings_overlay_new (void)
+{
+  GtkTimingsOverlay *self;
+
+  self = g_object_new (GTK_TYPE_TIMINGS_OVERLAY, NULL);
+
+  return GTK_INSPECTOR_OVERLAY (self);
+}
@@ -27,6 +27,7 @@
 #include "focusoverlay.h"
 #include "baselineoverlay.h"
 #include "subsurfaceoverlay.h"
+#include "timingsoverlay.h"
 #include "window.h"
 
 #include "gtkadjustment.h"
@@ -95,6 +96,7 @@ struct _GtkInspectorVisual
 
   GtkWidget *debug_box;
   GtkWidget *fps_switch;
+  GtkWidget *timings_switch;
   GtkWidget *updates_switch;
   GtkWidget *cairo_switch;
   GtkWidget *baselines_switch;
@@ -107,6 +109,7 @@ struct _GtkInspectorVisual
   GtkWidget *touchscreen_switch;
 
   GtkInspectorOverlay *fps_overlay;
+  GtkInspectorOverlay *timings_overlay;
   GtkInspectorOverlay *updates_overlay;
   GtkInspectorOverlay *layout_overlay;
   GtkInspectorOverlay *focus_overlay;
@@ -308,6 +311,40 @@ fps_activate (GtkSwitch          *sw,
   redraw_everything ();
 }
 
+static void
+timings_activate (GtkSwitch          *sw,
+                  GParamSpec         *pspec,
+                  GtkInspectorVisual *vis)
+{
+  GtkInspectorWindow *iw;
+  gboolean timings;
+
+  timings = gtk_switch_get_active (sw);
+  iw = GTK_INSPECTOR_WINDOW (gtk_widget_get_root (GTK_WIDGET (vis)));
+  if (iw == NULL)
+    return;
+
+  if (timings)
+    {
+      if (vis->timings_overlay == NULL)
+        {
+          vis->timings_overlay = gtk_timings_overlay_new ();
+          gtk_inspector_window_add_overlay (iw, vis->timings_overlay);
+          g_object_unref (vis->timings_overlay);
+        }
+    }
+  else
+    {
+      if (vis->timings_overlay != NULL)
+        {
+          gtk_inspector_window_remove_overlay (iw, vis->timings_overlay);
+          vis->timings_overlay = NULL;
+        }
+    }
+
+  redraw_everything ();
+}
+
 static void
 a11y_activate (GtkSwitch          *sw,
                GParamSpec         *pspec,
@@ -1119,6 +1156,11 @@ row_activated (GtkListBox         *box,
       GtkSwitch *sw = GTK_SWITCH (vis->fps_switch);
       gtk_switch_set_active (sw, !gtk_switch_get_active (sw));
     }
+  else if (gtk_widget_is_ancestor (vis->timings_switch, GTK_WIDGET (row)))
+    {
+      GtkSwitch *sw = GTK_SWITCH (vis->timings_switch);
+      gtk_switch_set_active (sw, !gtk_switch_get_active (sw));
+    }
   else if (gtk_widget_is_ancestor (vis->updates_switch, GTK_WIDGET (row)))
     {
       GtkSwitch *sw = GTK_SWITCH (vis->updates_switch);
@@ -1218,6 +1260,11 @@ gtk_inspector_visual_unroot (GtkWidget *widget)
       gtk_inspector_window_remove_overlay (iw, vis->fps_overlay);
       vis->fps_overlay = NULL;
     }
+  if (vis->timings_overlay)
+    {
+      gtk_inspector_window_remove_overlay (iw, vis->timings_overlay);
+      vis->timings_overlay = NULL;
+    }
   if (vis->focus_overlay)
     {
       gtk_inspector_window_remove_overlay (iw, vis->focus_overlay);
@@ -1276,6 +1323,7 @@ gtk_inspector_visual_class_init (GtkInspectorVisualClass *klass)
   gtk_widget_class_bind_template_child (widget_class, GtkInspectorVisual, font_scale_entry);
   gtk_widget_class_bind_template_child (widget_class, GtkInspectorVisual, font_scale_adjustment);
   gtk_widget_class_bind_template_child (widget_class, GtkInspectorVisual, fps_switch);
+  gtk_widget_class_bind_template_child (widget_class, GtkInspectorVisual, timings_switch);
   gtk_widget_class_bind_template_child (widget_class, GtkInspectorVisual, updates_switch);
   gtk_widget_class_bind_template_child (widget_class, GtkInspectorVisual, cairo_switch);
   gtk_widget_class_bind_template_child (widget_class, GtkInspectorVisual, baselines_switch);
@@ -1285,6 +1333,7 @@ gtk_inspector_visual_class_init (GtkInspectorVisualClass *klass)
   gtk_widget_class_bind_template_child (widget_class, GtkInspectorVisual, subsurface_switch);
 
   gtk_widget_class_bind_template_callback (widget_class, fps_activate);
+  gtk_widget_class_bind_template_callback (widget_class, timings_activate);
   gtk_widget_class_bind_template_callback (widget_class, updates_activate);
   gtk_widget_class_bind_template_callback (widget_class, cairo_activate);
   gtk_widget_class_bind_template_callback (widget_class, direction_changed);
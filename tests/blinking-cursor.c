@@ -0,0 +1,104 @@
+/* -*- mode: C; c-basic-offset: 2; indent-tabs-mode: nil; -*- */
+
+/* Redraws a single small widget every frame in a window with
+ * thousands of other widgets, like a blinking cursor would, to
+ * measure how much a tiny change costs in a large widget tree.
+ */
+
+#include <gtk/gtk.h>
+#include <math.h>
+
+#include "frame-stats.h"
+
+static int n_widgets = 5000;
+
+static GOptionEntry options[] = {
+  { "widgets", 'n', 0, G_OPTION_ARG_INT, &n_widgets, "Number of widgets in the window", "COUNT" },
+  { NULL }
+};
+
+static gboolean
+blink (GtkWidget     *cursor,
+       GdkFrameClock *frame_clock,
+       gpointer       user_data)
+{
+  gtk_widget_set_opacity (cursor, gtk_widget_get_opacity (cursor) > 0.5 ? 0.0 : 1.0);
+
+  return G_SOURCE_CONTINUE;
+}
+
+static void
+quit_cb (GtkWidget *widget,
+         gpointer   data)
+{
+  gboolean *done = data;
+
+  *done = TRUE;
+
+  g_main_context_wakeup (NULL);
+}
+
+int
+main (int argc, char **argv)
+{
+  GtkWidget *window;
+  GtkWidget *box;
+  GtkWidget *scrolled_window;
+  GtkWidget *grid;
+  GtkWidget *cursor;
+  GError *error = NULL;
+  gboolean done = FALSE;
+  int columns;
+  int i;
+
+  GOptionContext *context = g_option_context_new (NULL);
+  g_option_context_add_main_entries (context, options, NULL);
+  frame_stats_add_options (g_option_context_get_main_group (context));
+
+  if (!g_option_context_parse (context, &argc, &argv, &error))
+    {
+      g_printerr ("Option parsing failed: %s\n", error->message);
+      return 1;
+    }
+
+  gtk_init ();
+
+  window = gtk_window_new ();
+  frame_stats_ensure (GTK_WINDOW (window));
+  gtk_window_set_default_size (GTK_WINDOW (window), 800, 600);
+
+  box = gtk_box_new (GTK_ORIENTATION_VERTICAL, 6);
+  gtk_window_set_child (GTK_WINDOW (window), box);
+
+  cursor = gtk_label_new ("|");
+  gtk_widget_set_halign (cursor, GTK_ALIGN_START);
+  gtk_box_append (GTK_BOX (box), cursor);
+
+  scrolled_window = gtk_scrolled_window_new ();
+  gtk_widget_set_vexpand (scrolled_window, TRUE);
+  gtk_box_append (GTK_BOX (box), scrolled_window);
+
+  grid = gtk_grid_new ();
+  gtk_scrolled_window_set_child (GTK_SCROLLED_WINDOW (scrolled_window), grid);
+
+  columns = MAX (1, (int) sqrt (n_widgets));
+  for (i = 0; i < n_widgets; i++)
+    {
+      char *text = g_strdup_printf ("Label %d", i);
+
+      gtk_grid_attach (GTK_GRID (grid), gtk_label_new (text),
+                       i % columns, i / columns, 1, 1);
+      g_free (text);
+    }
+
+  gtk_widget_add_tick_callback (cursor, blink, NULL, NULL);
+
+  gtk_window_present (GTK_WINDOW (window));
+  g_signal_connect (window, "destroy",
+                    G_CALLBACK (quit_cb), &done);
+
+  while (!done)
+    g_main_context_iteration (NULL, TRUE);
+
+  return 0;
+}
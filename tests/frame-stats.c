@@ -18,6 +18,8 @@ struct FrameStats
   gint64 last_handled_frame;
 
   Variable latency;
+  GArray *frame_times;
+  int missed_deadlines;
 };
 
 static int max_stats = -1;
@@ -71,6 +73,52 @@ print_variable (const char *description,
     }
 }
 
+static int
+compare_doubles (gconstpointer a,
+                 gconstpointer b)
+{
+  double da = *(const double *) a;
+  double db = *(const double *) b;
+
+  return (da > db) - (da < db);
+}
+
+static void
+print_percentiles (const char *description,
+                   GArray     *values)
+{
+  static const double percentiles[] = { 50, 90, 99 };
+  guint i;
+
+  if (values->len == 0)
+    {
+      if (machine_readable)
+        g_print ("-\t-\t-\t");
+      else
+        g_print ("%s: <n/a>\n", description);
+      return;
+    }
+
+  g_array_sort (values, compare_doubles);
+
+  if (!machine_readable)
+    g_print ("%s:", description);
+
+  for (i = 0; i < G_N_ELEMENTS (percentiles); i++)
+    {
+      guint index = MIN (values->len - 1, values->len * percentiles[i] / 100);
+      double value = g_array_index (values, double, index);
+
+      if (machine_readable)
+        g_print ("%g\t", value);
+      else
+        g_print (" p%g %g", percentiles[i], value);
+    }
+
+  if (!machine_readable)
+    g_print ("\n");
+}
+
 static void
 on_frame_clock_after_paint (GdkFrameClock *frame_clock,
                             FrameStats    *frame_stats)
@@ -85,7 +133,7 @@ on_frame_clock_after_paint (GdkFrameClock *frame_clock,
         {
           if (frame_stats->num_stats == 0 && machine_readable)
             {
-              g_print ("# load_factor frame_rate latency\n");
+              g_print ("# frame_rate latency latency_sd frame_time_p50 frame_time_p90 frame_time_p99 missed_deadlines\n");
             }
 
           frame_stats->num_stats++;
@@ -95,12 +143,18 @@ on_frame_clock_after_paint (GdkFrameClock *frame_clock,
 
           print_variable ("Latency", &frame_stats->latency);
 
+          print_percentiles ("Frame time", frame_stats->frame_times);
+
+          print_double ("Missed deadlines", frame_stats->missed_deadlines);
+
           g_print ("\n");
         }
 
       frame_stats->last_print_time = current_time;
       frame_stats->frames_since_last_print = 0;
       variable_init (&frame_stats->latency);
+      g_array_set_size (frame_stats->frame_times, 0);
+      frame_stats->missed_deadlines = 0;
 
       if (frame_stats->num_stats == max_stats)
         exit (0);
@@ -127,6 +181,17 @@ on_frame_clock_after_paint (GdkFrameClock *frame_clock,
 
           variable_add_weighted (&frame_stats->latency, frame_latency, display_time);
         }
+
+      if (timings && gdk_frame_timings_get_complete (timings) && previous_timings)
+        {
+          double frame_time = (gdk_frame_timings_get_frame_time (timings) - gdk_frame_timings_get_frame_time (previous_timings)) / 1000.;
+
+          g_array_append_val (frame_stats->frame_times, frame_time);
+        }
+
+      if (timings && gdk_frame_timings_get_complete (timings) &&
+          gdk_frame_timings_get_deadline_missed (timings))
+        frame_stats->missed_deadlines++;
     }
 }
 
@@ -153,6 +218,7 @@ static void
 on_window_destroy (GtkWidget  *window,
                    FrameStats *stats)
 {
+  g_array_unref (stats->frame_times);
   g_free (stats);
 }
 
@@ -169,6 +235,7 @@ frame_stats_ensure (GtkWindow *window)
   g_object_set_data (G_OBJECT (window), "frame-stats", frame_stats);
 
   variable_init (&frame_stats->latency);
+  frame_stats->frame_times = g_array_new (FALSE, FALSE, sizeof (double));
   frame_stats->last_handled_frame = -1;
 
   g_signal_connect (window, "realize",
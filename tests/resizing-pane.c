@@ -0,0 +1,146 @@
+/* -*- mode: C; c-basic-offset: 2; indent-tabs-mode: nil; -*- */
+
+/* Moves the handle of a pane with wrapping labels every frame,
+ * next to a large part of the window whose size does not change,
+ * to measure how much relayouting a resizing window costs.
+ */
+
+#include <gtk/gtk.h>
+#include <math.h>
+
+#include "frame-stats.h"
+
+static int n_widgets = 2000;
+static int n_paragraphs = 20;
+
+static GOptionEntry options[] = {
+  { "widgets", 'n', 0, G_OPTION_ARG_INT, &n_widgets, "Number of widgets that keep their size", "COUNT" },
+  { "paragraphs", 'p', 0, G_OPTION_ARG_INT, &n_paragraphs, "Number of wrapping labels in each pane", "COUNT" },
+  { NULL }
+};
+
+static const char lorem[] =
+  "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod "
+  "tempor incididunt ut labore et dolore magna aliqua. Ut enim ad minim veniam, "
+  "quis nostrud exercitation ullamco laboris nisi ut aliquip ex ea commodo "
+  "consequat. Duis aute irure dolor in reprehenderit in voluptate velit esse "
+  "cillum dolore eu fugiat nulla pariatur.";
+
+static gboolean
+move_handle (GtkWidget     *paned,
+             GdkFrameClock *frame_clock,
+             gpointer       user_data)
+{
+  double t = gdk_frame_clock_get_frame_time (frame_clock) / (double) G_USEC_PER_SEC;
+  int width = gtk_widget_get_width (paned);
+
+  gtk_paned_set_position (GTK_PANED (paned), width / 2 + width / 4 * sin (t * G_PI));
+
+  return G_SOURCE_CONTINUE;
+}
+
+static GtkWidget *
+create_pane (void)
+{
+  GtkWidget *scrolled_window;
+  GtkWidget *box;
+  int i;
+
+  box = gtk_box_new (GTK_ORIENTATION_VERTICAL, 12);
+
+  for (i = 0; i < n_paragraphs; i++)
+    {
+      GtkWidget *label = gtk_label_new (lorem);
+
+      gtk_label_set_wrap (GTK_LABEL (label), TRUE);
+      gtk_label_set_xalign (GTK_LABEL (label), 0);
+      gtk_box_append (GTK_BOX (box), label);
+    }
+
+  scrolled_window = gtk_scrolled_window_new ();
+  gtk_scrolled_window_set_policy (GTK_SCROLLED_WINDOW (scrolled_window),
+                                  GTK_POLICY_NEVER, GTK_POLICY_AUTOMATIC);
+  gtk_scrolled_window_set_child (GTK_SCROLLED_WINDOW (scrolled_window), box);
+
+  return scrolled_window;
+}
+
+static void
+quit_cb (GtkWidget *widget,
+         gpointer   data)
+{
+  gboolean *done = data;
+
+  *done = TRUE;
+
+  g_main_context_wakeup (NULL);
+}
+
+int
+main (int argc, char **argv)
+{
+  GtkWidget *window;
+  GtkWidget *box;
+  GtkWidget *paned;
+  GtkWidget *scrolled_window;
+  GtkWidget *grid;
+  GError *error = NULL;
+  gboolean done = FALSE;
+  int columns;
+  int i;
+
+  GOptionContext *context = g_option_context_new (NULL);
+  g_option_context_add_main_entries (context, options, NULL);
+  frame_stats_add_options (g_option_context_get_main_group (context));
+
+  if (!g_option_context_parse (context, &argc, &argv, &error))
+    {
+      g_printerr ("Option parsing failed: %s\n", error->message);
+      return 1;
+    }
+
+  gtk_init ();
+
+  window = gtk_window_new ();
+  frame_stats_ensure (GTK_WINDOW (window));
+  gtk_window_set_default_size (GTK_WINDOW (window), 800, 600);
+
+  box = gtk_box_new (GTK_ORIENTATION_VERTICAL, 6);
+  gtk_window_set_child (GTK_WINDOW (window), box);
+
+  paned = gtk_paned_new (GTK_ORIENTATION_HORIZONTAL);
+  gtk_widget_set_vexpand (paned, TRUE);
+  gtk_paned_set_start_child (GTK_PANED (paned), create_pane ());
+  gtk_paned_set_end_child (GTK_PANED (paned), create_pane ());
+  gtk_paned_set_shrink_start_child (GTK_PANED (paned), FALSE);
+  gtk_paned_set_shrink_end_child (GTK_PANED (paned), FALSE);
+  gtk_box_append (GTK_BOX (box), paned);
+
+  scrolled_window = gtk_scrolled_window_new ();
+  gtk_scrolled_window_set_min_content_height (GTK_SCROLLED_WINDOW (scrolled_window), 200);
+  gtk_box_append (GTK_BOX (box), scrolled_window);
+
+  grid = gtk_grid_new ();
+  gtk_scrolled_window_set_child (GTK_SCROLLED_WINDOW (scrolled_window), grid);
+
+  columns = MAX (1, (int) sqrt (n_widgets));
+  for (i = 0; i < n_widgets; i++)
+    {
+      char *text = g_strdup_printf ("Label %d", i);
+
+      gtk_grid_attach (GTK_GRID (grid), gtk_label_new (text),
+                       i % columns, i / columns, 1, 1);
+      g_free (text);
+    }
+
+  gtk_widget_add_tick_callback (paned, move_handle, NULL, NULL);
+
+  gtk_window_present (GTK_WINDOW (window));
+  g_signal_connect (window, "destroy",
+                    G_CALLBACK (quit_cb), &done);
+
+  while (!done)
+    g_main_context_iteration (NULL, TRUE);
+
+  return 0;
+}
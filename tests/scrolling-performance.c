@@ -86,7 +86,90 @@ scroll_viewport (GtkWidget     *viewport,
   return TRUE;
 }
 
+static void
+setup_list_item (GtkSignalListItemFactory *factory,
+                 GtkListItem              *item)
+{
+  GtkWidget *label;
+
+  label = gtk_label_new (NULL);
+  gtk_label_set_xalign (GTK_LABEL (label), 0);
+  gtk_list_item_set_child (item, label);
+}
+
+static void
+bind_list_item (GtkSignalListItemFactory *factory,
+                GtkListItem              *item)
+{
+  GtkWidget *label;
+  guint position, n_lines, i;
+  GString *string;
+
+  label = gtk_list_item_get_child (item);
+  position = gtk_list_item_get_position (item);
+
+  /* rows of 1 to 4 lines, so the list has to guess unknown heights */
+  n_lines = 1 + g_int_hash (&position) % 4;
+  string = g_string_new (NULL);
+  for (i = 0; i < n_lines; i++)
+    {
+      if (i > 0)
+        g_string_append_c (string, '\n');
+      g_string_append_printf (string, "Row %u, line %u", position, i + 1);
+    }
+
+  gtk_label_set_text (GTK_LABEL (label), string->str);
+  g_string_free (string, TRUE);
+}
+
+static GtkWidget *
+create_list_view (guint n_items)
+{
+  GtkListItemFactory *factory;
+  GtkStringList *list;
+  guint i;
+
+  factory = gtk_signal_list_item_factory_new ();
+  g_signal_connect (factory, "setup", G_CALLBACK (setup_list_item), NULL);
+  g_signal_connect (factory, "bind", G_CALLBACK (bind_list_item), NULL);
+
+  list = gtk_string_list_new (NULL);
+  for (i = 0; i < n_items; i++)
+    gtk_string_list_append (list, "");
+
+  return gtk_list_view_new (GTK_SELECTION_MODEL (gtk_no_selection_new (G_LIST_MODEL (list))),
+                            factory);
+}
+
+static gboolean
+fling_list (GtkWidget     *list,
+            GdkFrameClock *frame_clock,
+            gpointer       user_data)
+{
+  static gint64 start_time;
+  gint64 now = gdk_frame_clock_get_frame_time (frame_clock);
+  double elapsed;
+  GtkAdjustment *vadjustment;
+
+  if (start_time == 0)
+    start_time = now;
+
+  elapsed = (now - start_time) / 1000000.;
+
+  vadjustment = gtk_scrollable_get_vadjustment (GTK_SCROLLABLE (list));
+
+  /* sweep from top to bottom and back every 10 seconds */
+  set_adjustment_to_fraction (vadjustment, 0.5 - 0.5 * cos (elapsed * G_PI / 5));
+
+  return TRUE;
+}
+
+static int n_list_items = 0;
+static int estimated_row_height = -1;
+
 static GOptionEntry options[] = {
+  { "list", 'l', 0, G_OPTION_ARG_INT, &n_list_items, "Fling through a list view with this many rows", "ROWS" },
+  { "estimated-row-height", 'e', 0, G_OPTION_ARG_INT, &estimated_row_height, "Estimated row height of the list view", "HEIGHT" },
   { NULL }
 };
 
@@ -131,25 +214,36 @@ main (int argc, char **argv)
   scrolled_window = gtk_scrolled_window_new ();
   gtk_window_set_child (GTK_WINDOW (window), scrolled_window);
 
-  viewport = gtk_viewport_new (NULL, NULL);
-  gtk_scrolled_window_set_child (GTK_SCROLLED_WINDOW (scrolled_window), viewport);
-
-  grid = gtk_grid_new ();
-  gtk_viewport_set_child (GTK_VIEWPORT (viewport), grid);
+  if (n_list_items > 0)
+    {
+      GtkWidget *list = create_list_view (n_list_items);
 
-  for (i = 0; i < 4; i++)
+      gtk_list_view_set_estimated_row_height (GTK_LIST_VIEW (list), estimated_row_height);
+      gtk_scrolled_window_set_child (GTK_SCROLLED_WINDOW (scrolled_window), list);
+      gtk_widget_add_tick_callback (list, fling_list, NULL, NULL);
+    }
+  else
     {
-      GtkWidget *content = create_widget_factory_content ();
-      gtk_grid_attach (GTK_GRID (grid), content,
-                       i % 2, i / 2, 1, 1);
-      g_object_unref (content);
+      viewport = gtk_viewport_new (NULL, NULL);
+      gtk_scrolled_window_set_child (GTK_SCROLLED_WINDOW (scrolled_window), viewport);
+
+      grid = gtk_grid_new ();
+      gtk_viewport_set_child (GTK_VIEWPORT (viewport), grid);
+
+      for (i = 0; i < 4; i++)
+        {
+          GtkWidget *content = create_widget_factory_content ();
+          gtk_grid_attach (GTK_GRID (grid), content,
+                           i % 2, i / 2, 1, 1);
+          g_object_unref (content);
+        }
+
+      gtk_widget_add_tick_callback (viewport,
+                                    scroll_viewport,
+                                    NULL,
+                                    NULL);
     }
 
-  gtk_widget_add_tick_callback (viewport,
-                                scroll_viewport,
-                                NULL,
-                                NULL);
-
   gtk_window_present (GTK_WINDOW (window));
   g_signal_connect (window, "destroy",
                     G_CALLBACK (quit_cb), &done);
@@ -0,0 +1,134 @@
+/* -*- mode: C; c-basic-offset: 2; indent-tabs-mode: nil; -*- */
+
+/* A wall of thumbnails with different aspect ratios, to check that
+ * the scrollbar does not jump when the gridview has to guess the
+ * height of rows that have not been displayed yet.
+ */
+
+#include <gtk/gtk.h>
+#include <stdlib.h>
+
+static int n_items = 100000;
+static gboolean estimate = TRUE;
+
+static GOptionEntry options[] = {
+  { "items", 'n', 0, G_OPTION_ARG_INT, &n_items, "Number of items", "ITEMS" },
+  { "no-estimate", 0, G_OPTION_FLAG_REVERSE, G_OPTION_ARG_NONE, &estimate, "Don't estimate item sizes", NULL },
+  { NULL }
+};
+
+/* height per 100 pixels of width */
+static const int aspects[] = { 56, 75, 100, 133, 150, 178 };
+
+static int
+get_item_height (gpointer item,
+                 int      width)
+{
+  guint i = atoi (gtk_string_object_get_string (item));
+
+  return width * aspects[g_int_hash (&i) % G_N_ELEMENTS (aspects)] / 100;
+}
+
+static int
+item_size_func (gpointer item,
+                int      column_width,
+                gpointer user_data)
+{
+  return get_item_height (item, column_width);
+}
+
+static void
+setup_item (GtkSignalListItemFactory *factory,
+            GtkListItem              *list_item)
+{
+  GtkWidget *label = gtk_label_new ("");
+
+  gtk_widget_add_css_class (label, "card");
+  gtk_list_item_set_child (list_item, label);
+}
+
+static void
+bind_item (GtkSignalListItemFactory *factory,
+           GtkListItem              *list_item)
+{
+  GtkWidget *label;
+  gpointer item;
+
+  item = gtk_list_item_get_item (list_item);
+  label = gtk_list_item_get_child (list_item);
+
+  gtk_label_set_text (GTK_LABEL (label), gtk_string_object_get_string (item));
+  gtk_widget_set_size_request (label, -1, get_item_height (item, 160));
+}
+
+static GListModel *
+create_model (void)
+{
+  GtkStringList *list;
+  int i;
+
+  list = gtk_string_list_new (NULL);
+  for (i = 0; i < n_items; i++)
+    {
+      char *s = g_strdup_printf ("%d", i);
+      gtk_string_list_take (list, s);
+    }
+
+  return G_LIST_MODEL (list);
+}
+
+static void
+quit_cb (GtkWidget *widget,
+         gpointer   data)
+{
+  gboolean *done = data;
+
+  *done = TRUE;
+
+  g_main_context_wakeup (NULL);
+}
+
+int
+main (int argc, char *argv[])
+{
+  GOptionContext *context;
+  GError *error = NULL;
+  GtkWidget *window, *sw, *grid;
+  GtkListItemFactory *factory;
+  gboolean done = FALSE;
+
+  context = g_option_context_new ("- gridview with variable item sizes");
+  g_option_context_add_main_entries (context, options, NULL);
+  if (!g_option_context_parse (context, &argc, &argv, &error))
+    {
+      g_printerr ("Option parsing failed: %s\n", error->message);
+      return 1;
+    }
+  g_option_context_free (context);
+
+  gtk_init ();
+
+  window = gtk_window_new ();
+  gtk_window_set_default_size (GTK_WINDOW (window), 800, 600);
+  g_signal_connect (window, "destroy", G_CALLBACK (quit_cb), &done);
+
+  sw = gtk_scrolled_window_new ();
+  gtk_window_set_child (GTK_WINDOW (window), sw);
+
+  factory = gtk_signal_list_item_factory_new ();
+  g_signal_connect (factory, "setup", G_CALLBACK (setup_item), NULL);
+  g_signal_connect (factory, "bind", G_CALLBACK (bind_item), NULL);
+
+  grid = gtk_grid_view_new (GTK_SELECTION_MODEL (gtk_no_selection_new (create_model ())), factory);
+  gtk_grid_view_set_max_columns (GTK_GRID_VIEW (grid), 5);
+  if (estimate)
+    gtk_grid_view_set_item_size_func (GTK_GRID_VIEW (grid), item_size_func, NULL, NULL);
+  gtk_scrolled_window_set_child (GTK_SCROLLED_WINDOW (sw), grid);
+
+  gtk_window_present (GTK_WINDOW (window));
+
+  while (!done)
+    g_main_context_iteration (NULL, TRUE);
+
+  return 0;
+}
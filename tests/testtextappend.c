@@ -0,0 +1,146 @@
+/* -*- mode: C; c-basic-offset: 2; indent-tabs-mode: nil; -*- */
+
+/* Measures how fast text can be appended to a GtkTextBuffer,
+ * line by line, in batches and when loading it all at once.
+ */
+
+#include <gtk/gtk.h>
+#include <string.h>
+
+static int n_lines = 200000;
+static int batch_size = 1000;
+static gboolean with_view = FALSE;
+static gboolean with_undo = FALSE;
+
+static GOptionEntry options[] = {
+  { "lines", 'n', 0, G_OPTION_ARG_INT, &n_lines, "Number of lines to append", "LINES" },
+  { "batch", 'b', 0, G_OPTION_ARG_INT, &batch_size, "Number of lines per batch", "LINES" },
+  { "view", 'v', 0, G_OPTION_ARG_NONE, &with_view, "Attach a text view to the buffer", NULL },
+  { "undo", 'u', 0, G_OPTION_ARG_NONE, &with_undo, "Keep undo enabled", NULL },
+  { NULL }
+};
+
+static GPtrArray *
+create_lines (void)
+{
+  GPtrArray *lines;
+  int i;
+
+  lines = g_ptr_array_new_with_free_func (g_free);
+
+  for (i = 0; i < n_lines; i++)
+    g_ptr_array_add (lines,
+                     g_strdup_printf ("[%8d.%03d] worker %d: processed item %d of batch %d\n",
+                                      i / 1000, i % 1000, i % 16, i, i / 97));
+
+  return lines;
+}
+
+static GtkTextBuffer *
+create_buffer (GtkWidget **view)
+{
+  GtkTextBuffer *buffer;
+
+  buffer = gtk_text_buffer_new (NULL);
+  gtk_text_buffer_set_enable_undo (buffer, with_undo);
+
+  if (with_view)
+    *view = g_object_ref_sink (gtk_text_view_new_with_buffer (buffer));
+  else
+    *view = NULL;
+
+  return buffer;
+}
+
+static void
+free_buffer (GtkTextBuffer *buffer,
+             GtkWidget     *view)
+{
+  g_clear_object (&view);
+  g_object_unref (buffer);
+}
+
+static void
+report (const char *name,
+        gsize       n_bytes,
+        gint64      usecs)
+{
+  g_print ("%-12s %8.1f ms %8.1f MB/s\n",
+           name,
+           usecs / 1000.,
+           usecs > 0 ? (double) n_bytes / usecs : 0.);
+}
+
+int
+main (int argc, char *argv[])
+{
+  GOptionContext *context;
+  GError *error = NULL;
+  GtkTextBuffer *buffer;
+  GtkWidget *view;
+  GtkTextIter end;
+  GPtrArray *lines;
+  GString *batch;
+  GBytes *bytes;
+  gsize n_bytes;
+  gint64 start;
+  guint i;
+
+  context = g_option_context_new ("- text buffer append benchmark");
+  g_option_context_add_main_entries (context, options, NULL);
+  if (!g_option_context_parse (context, &argc, &argv, &error))
+    {
+      g_printerr ("Option parsing failed: %s\n", error->message);
+      return 1;
+    }
+  g_option_context_free (context);
+
+  gtk_init ();
+
+  lines = create_lines ();
+  n_bytes = 0;
+  for (i = 0; i < lines->len; i++)
+    n_bytes += strlen (g_ptr_array_index (lines, i));
+
+  /* one insertion per line */
+  buffer = create_buffer (&view);
+  start = g_get_monotonic_time ();
+  for (i = 0; i < lines->len; i++)
+    {
+      gtk_text_buffer_get_end_iter (buffer, &end);
+      gtk_text_buffer_insert (buffer, &end, g_ptr_array_index (lines, i), -1);
+    }
+  report ("per-line", n_bytes, g_get_monotonic_time () - start);
+  free_buffer (buffer, view);
+
+  /* one insertion per batch */
+  buffer = create_buffer (&view);
+  batch = g_string_new (NULL);
+  start = g_get_monotonic_time ();
+  for (i = 0; i < lines->len; i++)
+    {
+      g_string_append (batch, g_ptr_array_index (lines, i));
+      if ((i + 1) % MAX (batch_size, 1) == 0 || i + 1 == lines->len)
+        {
+          gtk_text_buffer_get_end_iter (buffer, &end);
+          gtk_text_buffer_insert (buffer, &end, batch->str, batch->len);
+          g_string_truncate (batch, 0);
+        }
+    }
+  report ("batched", n_bytes, g_get_monotonic_time () - start);
+  free_buffer (buffer, view);
+
+  /* loading everything at once */
+  for (i = 0; i < lines->len; i++)
+    g_string_append (batch, g_ptr_array_index (lines, i));
+  bytes = g_string_free_to_bytes (batch);
+  start = g_get_monotonic_time ();
+  buffer = gtk_text_buffer_new_from_bytes (NULL, bytes);
+  report ("from-bytes", n_bytes, g_get_monotonic_time () - start);
+  g_object_unref (buffer);
+  g_bytes_unref (bytes);
+
+  g_ptr_array_unref (lines);
+
+  return 0;
+}
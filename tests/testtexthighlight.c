@@ -0,0 +1,250 @@
+/* -*- mode: C; c-basic-offset: 2; indent-tabs-mode: nil; -*- */
+
+/* Simulates a syntax highlighter that rehighlights the lines around
+ * the cursor after every keystroke, and measures how long applying
+ * the tags takes, one range at a time and in batches.
+ */
+
+#include <gtk/gtk.h>
+#include <string.h>
+
+static int n_lines = 50000;
+static int n_keystrokes = 50;
+static int region = 500;
+static gboolean with_view = FALSE;
+
+static GOptionEntry options[] = {
+  { "lines", 'n', 0, G_OPTION_ARG_INT, &n_lines, "Number of lines in the file", "LINES" },
+  { "keystrokes", 'k', 0, G_OPTION_ARG_INT, &n_keystrokes, "Number of keystrokes to simulate", "COUNT" },
+  { "region", 'r', 0, G_OPTION_ARG_INT, &region, "Number of lines to rehighlight per keystroke", "LINES" },
+  { "view", 'v', 0, G_OPTION_ARG_NONE, &with_view, "Attach a text view to the buffer", NULL },
+  { NULL }
+};
+
+static const char *keywords[] = {
+  "static", "int", "return", "if", "else", "for", "while", "const", "char", "void"
+};
+
+enum {
+  KEYWORD,
+  NUMBER,
+  COMMENT,
+  N_STYLES
+};
+
+typedef struct {
+  GArray *starts;
+  GArray *ends;
+} Ranges;
+
+static GtkTextBuffer *
+create_buffer (GtkTextTag **tags)
+{
+  GtkTextBuffer *buffer;
+  GString *text;
+  int i;
+
+  text = g_string_new (NULL);
+  for (i = 0; i < n_lines; i++)
+    {
+      switch (i % 4)
+        {
+        case 0:
+          g_string_append_printf (text, "static int function_%d (int x) /* line %d */\n", i, i);
+          break;
+        case 1:
+          g_string_append_printf (text, "{ if (x > %d) return x * %d; else return %d; }\n", i, i % 7, i % 13);
+          break;
+        case 2:
+          g_string_append_printf (text, "  for (const char *p = s; *p; p++) count += %d;\n", i % 100);
+          break;
+        default:
+          g_string_append (text, "\n");
+          break;
+        }
+    }
+
+  buffer = gtk_text_buffer_new (NULL);
+  gtk_text_buffer_set_enable_undo (buffer, FALSE);
+  gtk_text_buffer_set_text (buffer, text->str, text->len);
+  g_string_free (text, TRUE);
+
+  tags[KEYWORD] = gtk_text_buffer_create_tag (buffer, NULL, "foreground", "blue", "weight", PANGO_WEIGHT_BOLD, NULL);
+  tags[NUMBER] = gtk_text_buffer_create_tag (buffer, NULL, "foreground", "red", NULL);
+  tags[COMMENT] = gtk_text_buffer_create_tag (buffer, NULL, "foreground", "gray", "style", PANGO_STYLE_ITALIC, NULL);
+
+  if (with_view)
+    g_object_ref_sink (gtk_text_view_new_with_buffer (buffer));
+
+  return buffer;
+}
+
+static gboolean
+is_keyword (const char *word,
+            gsize       len)
+{
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (keywords); i++)
+    if (strlen (keywords[i]) == len && strncmp (keywords[i], word, len) == 0)
+      return TRUE;
+
+  return FALSE;
+}
+
+/* A tiny tokenizer, good enough to produce a realistic number of tags */
+static void
+tokenize (const char *text,
+          int         offset,
+          Ranges     *ranges)
+{
+  const char *p = text;
+
+  while (*p)
+    {
+      int start;
+      const char *q;
+
+      if (p[0] == '/' && p[1] == '*')
+        {
+          q = strstr (p + 2, "*/");
+          q = q ? q + 2 : p + strlen (p);
+          start = offset + (p - text);
+          g_array_append_val (ranges[COMMENT].starts, start);
+          start += q - p;
+          g_array_append_val (ranges[COMMENT].ends, start);
+          p = q;
+        }
+      else if (g_ascii_isdigit (*p))
+        {
+          for (q = p; g_ascii_isdigit (*q); q++);
+          start = offset + (p - text);
+          g_array_append_val (ranges[NUMBER].starts, start);
+          start += q - p;
+          g_array_append_val (ranges[NUMBER].ends, start);
+          p = q;
+        }
+      else if (g_ascii_isalpha (*p) || *p == '_')
+        {
+          for (q = p; g_ascii_isalnum (*q) || *q == '_'; q++);
+          if (is_keyword (p, q - p))
+            {
+              start = offset + (p - text);
+              g_array_append_val (ranges[KEYWORD].starts, start);
+              start += q - p;
+              g_array_append_val (ranges[KEYWORD].ends, start);
+            }
+          p = q;
+        }
+      else
+        p++;
+    }
+}
+
+static gint64
+run (gboolean batched)
+{
+  GtkTextBuffer *buffer;
+  GtkTextTag *tags[N_STYLES];
+  Ranges ranges[N_STYLES];
+  gint64 total = 0;
+  int k, i;
+
+  buffer = create_buffer (tags);
+
+  for (i = 0; i < N_STYLES; i++)
+    {
+      ranges[i].starts = g_array_new (FALSE, FALSE, sizeof (int));
+      ranges[i].ends = g_array_new (FALSE, FALSE, sizeof (int));
+    }
+
+  for (k = 0; k < n_keystrokes; k++)
+    {
+      GtkTextIter start, end, iter;
+      int line = (n_lines / 2 + k * 97) % MAX (n_lines - region, 1);
+      char *text;
+      gint64 before;
+
+      gtk_text_buffer_get_iter_at_line (buffer, &iter, line + region / 2);
+      gtk_text_buffer_insert (buffer, &iter, "1", 1);
+
+      before = g_get_monotonic_time ();
+
+      gtk_text_buffer_get_iter_at_line (buffer, &start, line);
+      gtk_text_buffer_get_iter_at_line (buffer, &end, line + region);
+
+      for (i = 0; i < N_STYLES; i++)
+        {
+          gtk_text_buffer_remove_tag (buffer, tags[i], &start, &end);
+          g_array_set_size (ranges[i].starts, 0);
+          g_array_set_size (ranges[i].ends, 0);
+        }
+
+      text = gtk_text_buffer_get_slice (buffer, &start, &end, TRUE);
+      tokenize (text, gtk_text_iter_get_offset (&start), ranges);
+      g_free (text);
+
+      for (i = 0; i < N_STYLES; i++)
+        {
+          if (batched)
+            {
+              gtk_text_buffer_apply_tag_ranges (buffer, tags[i],
+                                                (int *) ranges[i].starts->data,
+                                                (int *) ranges[i].ends->data,
+                                                ranges[i].starts->len);
+            }
+          else
+            {
+              guint j;
+
+              for (j = 0; j < ranges[i].starts->len; j++)
+                {
+                  gtk_text_buffer_get_iter_at_offset (buffer, &start, g_array_index (ranges[i].starts, int, j));
+                  gtk_text_buffer_get_iter_at_offset (buffer, &end, g_array_index (ranges[i].ends, int, j));
+                  gtk_text_buffer_apply_tag (buffer, tags[i], &start, &end);
+                }
+            }
+        }
+
+      total += g_get_monotonic_time () - before;
+    }
+
+  for (i = 0; i < N_STYLES; i++)
+    {
+      g_array_unref (ranges[i].starts);
+      g_array_unref (ranges[i].ends);
+    }
+
+  g_object_unref (buffer);
+
+  return total;
+}
+
+int
+main (int argc, char *argv[])
+{
+  GOptionContext *context;
+  GError *error = NULL;
+  gint64 usecs;
+
+  context = g_option_context_new ("- text highlighting benchmark");
+  g_option_context_add_main_entries (context, options, NULL);
+  if (!g_option_context_parse (context, &argc, &argv, &error))
+    {
+      g_printerr ("Option parsing failed: %s\n", error->message);
+      return 1;
+    }
+  g_option_context_free (context);
+
+  gtk_init ();
+
+  n_keystrokes = MAX (n_keystrokes, 1);
+
+  usecs = run (FALSE);
+  g_print ("%-12s %8.2f ms per keystroke\n", "per-range", usecs / 1000. / n_keystrokes);
+
+  usecs = run (TRUE);
+  g_print ("%-12s %8.2f ms per keystroke\n", "batched", usecs / 1000. / n_keystrokes);
+
+  return 0;
+}
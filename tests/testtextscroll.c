@@ -16,12 +16,55 @@
  * License along with this library. If not, see <http://www.gnu.org/licenses/>.
  */
 #include <gtk/gtk.h>
+#include <stdlib.h>
 
 static GtkWidget *_margin;
 static GtkWidget *_align;
 static GtkWidget *_xalign;
 static GtkWidget *_yalign;
 
+static gboolean benchmark = FALSE;
+static gint64 start_time;
+static gint64 last_change_time;
+static double last_upper;
+static guint n_upper_changes;
+
+static GOptionEntry options[] = {
+  { "benchmark", 'b', 0, G_OPTION_ARG_NONE, &benchmark, "Report how long it takes for the scrollbar to settle", NULL },
+  { NULL }
+};
+
+#define SETTLE_TIMEOUT 2000 /* ms */
+
+static void
+adjustment_changed (GtkAdjustment *adjustment)
+{
+  double upper = gtk_adjustment_get_upper (adjustment);
+
+  if (upper == last_upper)
+    return;
+
+  last_upper = upper;
+  last_change_time = g_get_monotonic_time ();
+  n_upper_changes++;
+}
+
+static gboolean
+check_settled (gpointer data)
+{
+  if ((g_get_monotonic_time () - last_change_time) / 1000 < SETTLE_TIMEOUT)
+    return G_SOURCE_CONTINUE;
+
+  g_print ("time to stable scrollbar: %.1f ms (%u changes, final height %.0f px)\n",
+           (last_change_time - start_time) / 1000.,
+           n_upper_changes,
+           last_upper);
+
+  exit (0);
+
+  return G_SOURCE_REMOVE;
+}
+
 static void
 highlight_at_mark (GtkTextBuffer *buffer,
                    GtkTextMark   *mark,
@@ -112,6 +155,17 @@ main (int argc, char *argv[])
   GtkTextIter iter;
   GtkTextTag *tag;
   GdkRGBA bg;
+  GOptionContext *context;
+  GError *error = NULL;
+
+  context = g_option_context_new ("[FILE] - text view scrolling test");
+  g_option_context_add_main_entries (context, options, NULL);
+  if (!g_option_context_parse (context, &argc, &argv, &error))
+    {
+      g_printerr ("Option parsing failed: %s\n", error->message);
+      return 1;
+    }
+  g_option_context_free (context);
 
   gtk_init ();
 
@@ -184,6 +238,15 @@ main (int argc, char *argv[])
 
   gtk_window_set_child (GTK_WINDOW (window), box);
 
+  if (benchmark)
+    {
+      GtkAdjustment *vadj = gtk_scrolled_window_get_vadjustment (GTK_SCROLLED_WINDOW (sw));
+
+      g_signal_connect (vadj, "changed", G_CALLBACK (adjustment_changed), NULL);
+      start_time = last_change_time = g_get_monotonic_time ();
+      g_timeout_add (100, check_settled, NULL);
+    }
+
   gtk_window_present (GTK_WINDOW (window));
 
   while (1)
@@ -0,0 +1,219 @@
+#include <gtk.h>
+
+#include "gdk/gdkframeclockidleprivate.h"
+
+typedef struct {
+  GString *log;
+  char name;
+  guint n_runs;
+  guint id;
+  guint n_freed;
+  GdkFrameClock *clock;
+  guint remove_id;
+} Work;
+
+static gboolean
+log_work (GdkFrameClock *clock,
+          gint64         deadline,
+          gpointer       data)
+{
+  Work *work = data;
+
+  g_assert_true (work->clock == clock);
+  g_assert_cmpint (deadline, ==, gdk_frame_clock_get_frame_deadline (clock));
+
+  g_string_append_c (work->log, work->name);
+
+  if (work->remove_id)
+    {
+      gdk_frame_clock_remove_work (clock, work->remove_id);
+      work->remove_id = 0;
+    }
+
+  if (--work->n_runs == 0)
+    return G_SOURCE_REMOVE;
+
+  return G_SOURCE_CONTINUE;
+}
+
+static void
+free_work (gpointer data)
+{
+  Work *work = data;
+
+  work->n_freed++;
+}
+
+static void
+add_work (Work          *work,
+          GdkFrameClock *clock,
+          GString       *log,
+          char           name,
+          guint          n_runs)
+{
+  work->log = log;
+  work->name = name;
+  work->n_runs = n_runs;
+  work->n_freed = 0;
+  work->clock = clock;
+  work->remove_id = 0;
+  work->id = gdk_frame_clock_add_work (clock, log_work, work, free_work);
+  g_assert_cmpuint (work->id, !=, 0);
+}
+
+static void
+run_until_freed (Work *work)
+{
+  gint64 end_time = g_get_monotonic_time () + 5 * G_USEC_PER_SEC;
+
+  while (work->n_freed == 0)
+    {
+      g_main_context_iteration (NULL, TRUE);
+      g_assert_cmpint (g_get_monotonic_time (), <, end_time);
+    }
+}
+
+static GdkFrameClock *
+create_clock (void)
+{
+  GdkFrameClock *clock;
+
+  clock = _gdk_frame_clock_idle_new ();
+  /* Frame clocks start out frozen, like the ones of unmapped surfaces */
+  _gdk_frame_clock_inhibit_freeze (clock);
+
+  return clock;
+}
+
+static void
+test_work_order (void)
+{
+  GdkFrameClock *clock = create_clock ();
+  GString *log = g_string_new (NULL);
+  Work a, b, c;
+  gint64 counter;
+
+  counter = gdk_frame_clock_get_frame_counter (clock);
+
+  add_work (&a, clock, log, 'a', 2);
+  add_work (&b, clock, log, 'b', 3);
+  add_work (&c, clock, log, 'c', 1);
+  g_assert_cmpuint (a.id, !=, b.id);
+  g_assert_cmpuint (b.id, !=, c.id);
+
+  /* Adding work requests frames, nothing else needs to */
+  run_until_freed (&b);
+
+  /* Work runs round-robin, no matter how it is split across frames */
+  g_assert_cmpstr (log->str, ==, "abcabb");
+  g_assert_cmpuint (a.n_freed, ==, 1);
+  g_assert_cmpuint (b.n_freed, ==, 1);
+  g_assert_cmpuint (c.n_freed, ==, 1);
+  g_assert_cmpint (gdk_frame_clock_get_frame_counter (clock), >, counter);
+  g_assert_cmpint (gdk_frame_clock_get_frame_deadline (clock), >, 0);
+
+  g_string_free (log, TRUE);
+  g_object_unref (clock);
+}
+
+static void
+test_work_remove (void)
+{
+  GdkFrameClock *clock = create_clock ();
+  GString *log = g_string_new (NULL);
+  Work a, b, c;
+
+  add_work (&a, clock, log, 'a', 100);
+  add_work (&b, clock, log, 'b', 100);
+  add_work (&c, clock, log, 'c', 3);
+
+  /* Removing work that is not running frees it right away */
+  gdk_frame_clock_remove_work (clock, b.id);
+  g_assert_cmpuint (b.n_freed, ==, 1);
+
+  /* Work can remove itself while it runs */
+  a.remove_id = a.id;
+
+  run_until_freed (&c);
+
+  g_assert_cmpstr (log->str, ==, "accc");
+  g_assert_cmpuint (a.n_freed, ==, 1);
+  g_assert_cmpuint (b.n_freed, ==, 1);
+  g_assert_cmpuint (c.n_freed, ==, 1);
+
+  /* Work can remove other work while it runs */
+  g_string_truncate (log, 0);
+  add_work (&a, clock, log, 'a', 100);
+  add_work (&b, clock, log, 'b', 2);
+  a.remove_id = b.id;
+  add_work (&c, clock, log, 'c', 1);
+  c.remove_id = a.id;
+
+  run_until_freed (&c);
+
+  g_assert_cmpstr (log->str, ==, "ac");
+  g_assert_cmpuint (a.n_freed, ==, 1);
+  g_assert_cmpuint (b.n_freed, ==, 1);
+
+  g_string_free (log, TRUE);
+  g_object_unref (clock);
+}
+
+static gboolean
+thaw_clock (gpointer data)
+{
+  GdkFrameClock *clock = data;
+
+  _gdk_frame_clock_inhibit_freeze (clock);
+
+  return G_SOURCE_REMOVE;
+}
+
+/* Freezes the clock until the frame is "presented", like backends do */
+static void
+freeze_after_paint (GdkFrameClock *clock,
+                    guint         *n_frozen)
+{
+  (*n_frozen)++;
+  _gdk_frame_clock_uninhibit_freeze (clock);
+  g_timeout_add (1, thaw_clock, clock);
+}
+
+static void
+test_work_frozen (void)
+{
+  GdkFrameClock *clock = create_clock ();
+  GString *log = g_string_new (NULL);
+  guint n_frozen = 0;
+  Work a;
+
+  g_signal_connect (clock, "after-paint", G_CALLBACK (freeze_after_paint), &n_frozen);
+
+  add_work (&a, clock, log, 'a', 5);
+  run_until_freed (&a);
+
+  /* Every frame freezes the clock, work still makes progress and
+   * keeps requesting frames after the thaw
+   */
+  g_assert_cmpstr (log->str, ==, "aaaaa");
+  g_assert_cmpuint (n_frozen, >=, 5);
+
+  /* Let the last thaw happen before the clock goes away */
+  while (gdk_frame_clock_is_frozen (clock))
+    g_main_context_iteration (NULL, TRUE);
+
+  g_string_free (log, TRUE);
+  g_object_unref (clock);
+}
+
+int
+main (int argc, char *argv[])
+{
+  gtk_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/frameclock/work/order", test_work_order);
+  g_test_add_func ("/frameclock/work/remove", test_work_remove);
+  g_test_add_func ("/frameclock/work/frozen", test_work_frozen);
+
+  return g_test_run ();
+}
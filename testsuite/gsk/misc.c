@@ -253,6 +253,59 @@ G_GNUC_END_IGNORE_DEPRECATIONS
 
 }
 
+static void
+test_diff_budget (void)
+{
+  GskRenderNode *children1[10], *children2[10];
+  GskRenderNode *node1, *node2;
+  GskDiffBudget budget = { 0, };
+  cairo_region_t *region;
+  cairo_rectangle_int_t extents;
+
+  for (int i = 0; i < 10; i++)
+    {
+      children1[i] = gsk_color_node_new (&(GdkRGBA) { 1, 0, 0, 1 },
+                                         &GRAPHENE_RECT_INIT (i * 10, 0, 10, 10));
+      children2[i] = gsk_render_node_ref (children1[i]);
+    }
+
+  gsk_render_node_unref (children2[5]);
+  children2[5] = gsk_color_node_new (&(GdkRGBA) { 0, 0, 1, 1 },
+                                     &GRAPHENE_RECT_INIT (50, 0, 10, 10));
+
+  node1 = gsk_container_node_new (children1, 10);
+  node2 = gsk_container_node_new (children2, 10);
+
+  /* Without a deadline, only the changed child is damaged */
+  region = cairo_region_create ();
+  gsk_render_node_diff (node1, node2, &(GskDiffData) { region, NULL, &budget });
+  cairo_region_get_extents (region, &extents);
+  g_assert_cmpint (extents.x, ==, 50);
+  g_assert_cmpint (extents.width, ==, 10);
+  g_assert_false (budget.exceeded);
+  g_assert_cmpuint (budget.n_nodes, >, 0);
+  cairo_region_destroy (region);
+
+  /* With the deadline passed, everything is */
+  budget = (GskDiffBudget) { .deadline = 1 };
+  region = cairo_region_create ();
+  gsk_render_node_diff (node1, node2, &(GskDiffData) { region, NULL, &budget });
+  cairo_region_get_extents (region, &extents);
+  g_assert_cmpint (extents.x, ==, 0);
+  g_assert_cmpint (extents.width, ==, 100);
+  g_assert_true (budget.exceeded);
+  cairo_region_destroy (region);
+
+  gsk_render_node_unref (node1);
+  gsk_render_node_unref (node2);
+
+  for (int i = 0; i < 10; i++)
+    {
+      gsk_render_node_unref (children1[i]);
+      gsk_render_node_unref (children2[i]);
+    }
+}
+
 static void
 test_cairo_renderer (void)
 {
@@ -288,6 +341,7 @@ main (int argc, char *argv[])
   g_test_add_func ("/rendernode/border/uniform", test_bordernode_uniform);
   g_test_add_func ("/rendernode/conic-gradient/angle", test_conic_gradient_angle);
   g_test_add_func ("/rendernode/container/disjoint", test_container_disjoint);
+  g_test_add_func ("/rendernode/diff/budget", test_diff_budget);
   g_test_add_func ("/renderer/cairo", test_cairo_renderer);
   g_test_add_func ("/renderer/gl", test_gl_renderer);
 
@@ -589,6 +589,50 @@ test_bitset_iter_forward_reverse (void)
   gtk_bitset_unref (set);
 }
 
+static void
+test_next_range (void)
+{
+  GtkBitset *set;
+  guint first, last;
+
+  set = gtk_bitset_new_empty ();
+  g_assert_false (gtk_bitset_get_next_range (set, 0, &first, &last));
+  g_assert_cmpuint (first, ==, 0);
+  g_assert_cmpuint (last, ==, 0);
+
+  gtk_bitset_add (set, 3);
+  gtk_bitset_add_range_closed (set, 10, 100000);
+  gtk_bitset_add_range_closed (set, 100002, 100002);
+  gtk_bitset_add_range_closed (set, G_MAXUINT - 5, G_MAXUINT);
+
+  g_assert_true (gtk_bitset_get_next_range (set, 0, &first, &last));
+  g_assert_cmpuint (first, ==, 3);
+  g_assert_cmpuint (last, ==, 3);
+
+  g_assert_true (gtk_bitset_get_next_range (set, last + 1, &first, &last));
+  g_assert_cmpuint (first, ==, 10);
+  g_assert_cmpuint (last, ==, 100000);
+
+  g_assert_true (gtk_bitset_get_next_range (set, 500, &first, &last));
+  g_assert_cmpuint (first, ==, 500);
+  g_assert_cmpuint (last, ==, 100000);
+
+  g_assert_true (gtk_bitset_get_next_range (set, 100001, &first, &last));
+  g_assert_cmpuint (first, ==, 100002);
+  g_assert_cmpuint (last, ==, 100002);
+
+  g_assert_true (gtk_bitset_get_next_range (set, last + 1, &first, &last));
+  g_assert_cmpuint (first, ==, G_MAXUINT - 5);
+  g_assert_cmpuint (last, ==, G_MAXUINT);
+
+  gtk_bitset_remove (set, G_MAXUINT);
+  g_assert_true (gtk_bitset_get_next_range (set, G_MAXUINT - 5, &first, &last));
+  g_assert_cmpuint (last, ==, G_MAXUINT - 1);
+  g_assert_false (gtk_bitset_get_next_range (set, G_MAXUINT, &first, &last));
+
+  gtk_bitset_unref (set);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -610,6 +654,7 @@ main (int argc, char *argv[])
   g_test_add_func ("/bitset/iter/basic", test_iter);
   g_test_add_func ("/bitset/splice-overflow", test_splice_overflow);
   g_test_add_func ("/bitset/iter/forward-reverse", test_bitset_iter_forward_reverse);
+  g_test_add_func ("/bitset/next-range", test_next_range);
 
   return g_test_run ();
 }
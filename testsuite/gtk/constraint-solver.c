@@ -360,6 +360,109 @@ constraint_solver_paper (void)
   g_object_unref (solver);
 }
 
+/* A chain of variables, each at least 10 after the previous one,
+ * that gets dragged around by an edit variable in the middle
+ */
+static void
+constraint_solver_chain (guint n)
+{
+  GtkConstraintSolver *solver = gtk_constraint_solver_new ();
+  GtkConstraintVariable **vars;
+  GtkConstraintVariable *middle;
+  double elapsed;
+  guint i, j;
+
+  vars = g_new (GtkConstraintVariable *, n);
+
+  g_test_timer_start ();
+
+  gtk_constraint_solver_freeze (solver);
+
+  for (i = 0; i < n; i++)
+    {
+      char *name = g_strdup_printf ("x%u", i);
+
+      vars[i] = gtk_constraint_solver_create_variable (solver, NULL, name, 0.0);
+      gtk_constraint_solver_add_stay_variable (solver, vars[i], GTK_CONSTRAINT_STRENGTH_WEAK);
+
+      g_free (name);
+    }
+
+  gtk_constraint_solver_add_constraint (solver,
+                                        vars[0], GTK_CONSTRAINT_RELATION_GE,
+                                        gtk_constraint_expression_new (0.0),
+                                        GTK_CONSTRAINT_STRENGTH_REQUIRED);
+
+  for (i = 1; i < n; i++)
+    {
+      GtkConstraintExpression *e = gtk_constraint_expression_new_from_variable (vars[i - 1]);
+
+      gtk_constraint_expression_plus_constant (e, 10.0);
+      gtk_constraint_solver_add_constraint (solver,
+                                            vars[i], GTK_CONSTRAINT_RELATION_GE, e,
+                                            GTK_CONSTRAINT_STRENGTH_REQUIRED);
+    }
+
+  gtk_constraint_solver_thaw (solver);
+
+  elapsed = g_test_timer_elapsed ();
+  if (g_test_perf ())
+    g_test_minimized_result (elapsed, "adding %u constraints: %gsec", 2 * n, elapsed);
+
+  g_assert_cmpfloat_with_epsilon (gtk_constraint_variable_get_value (vars[0]), 0.0, 0.001);
+  g_assert_cmpfloat_with_epsilon (gtk_constraint_variable_get_value (vars[n - 1]), 10.0 * (n - 1), 0.001);
+
+  /* Every suggestion re-solves starting from the previous solution */
+  middle = vars[n / 2];
+  gtk_constraint_solver_add_edit_variable (solver, middle, GTK_CONSTRAINT_STRENGTH_STRONG);
+  gtk_constraint_solver_begin_edit (solver);
+
+  g_test_timer_start ();
+
+  for (j = 1; j <= 100; j++)
+    {
+      double value = 10.0 * (n / 2) + j;
+
+      gtk_constraint_solver_suggest_value (solver, middle, value);
+      gtk_constraint_solver_resolve (solver);
+
+      g_assert_cmpfloat_with_epsilon (gtk_constraint_variable_get_value (middle), value, 0.001);
+      g_assert_cmpfloat_with_epsilon (gtk_constraint_variable_get_value (vars[n - 1]),
+                                      value + 10.0 * (n - 1 - n / 2),
+                                      0.001);
+      g_assert_cmpfloat_with_epsilon (gtk_constraint_variable_get_value (vars[0]), 0.0, 0.001);
+    }
+
+  elapsed = g_test_timer_elapsed ();
+  if (g_test_perf ())
+    g_test_minimized_result (elapsed, "100 edits with %u constraints: %gsec", 2 * n, elapsed);
+
+  gtk_constraint_solver_remove_edit_variable (solver, middle);
+  gtk_constraint_solver_end_edit (solver);
+
+  for (i = 0; i < n; i++)
+    gtk_constraint_variable_unref (vars[i]);
+  g_free (vars);
+
+  g_object_unref (solver);
+}
+
+static void
+constraint_solver_performance (void)
+{
+  const guint sizes[] = { 500, 1000, 2500, 5000 };
+  guint i;
+
+  if (!g_test_perf ())
+    {
+      constraint_solver_chain (100);
+      return;
+    }
+
+  for (i = 0; i < G_N_ELEMENTS (sizes); i++)
+    constraint_solver_chain (sizes[i]);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -376,6 +479,7 @@ main (int argc, char *argv[])
   g_test_add_func ("/constraint-solver/cassowary", constraint_solver_cassowary);
   g_test_add_func ("/constraint-solver/edit/required", constraint_solver_edit_var_required);
   g_test_add_func ("/constraint-solver/edit/suggest", constraint_solver_edit_var_suggest);
+  g_test_add_func ("/constraint-solver/performance", constraint_solver_performance);
 
   return g_test_run ();
 }
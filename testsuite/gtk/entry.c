@@ -342,6 +342,51 @@ test_editable (void)
   g_object_unref (entry);
 }
 
+static void
+test_buffer_offsets (void)
+{
+  const char *pieces[] = { "abc", "\303\244\303\266", "x", "\342\202\254 euro", "" };
+  GtkEntryBuffer *buffer;
+  GString *expected;
+  guint i;
+
+  buffer = gtk_entry_buffer_new (NULL, 0);
+  expected = g_string_new (NULL);
+
+  /* Edit at positions that jump around, so that character offsets are
+   * looked up from the start, from the end and from the previous edit.
+   */
+  for (i = 0; i < 200; i++)
+    {
+      const char *piece = pieces[i % G_N_ELEMENTS (pieces)];
+      guint length = gtk_entry_buffer_get_length (buffer);
+      guint position = length > 0 ? (i * 7) % (length + 1) : 0;
+
+      gtk_entry_buffer_insert_text (buffer, position, piece, -1);
+      g_string_insert (expected,
+                       g_utf8_offset_to_pointer (expected->str, position) - expected->str,
+                       piece);
+
+      if (i % 3 == 2)
+        {
+          length = gtk_entry_buffer_get_length (buffer);
+          position = (i * 13) % length;
+
+          gtk_entry_buffer_delete_text (buffer, position, 2);
+          g_string_erase (expected,
+                          g_utf8_offset_to_pointer (expected->str, position) - expected->str,
+                          g_utf8_offset_to_pointer (expected->str, MIN (position + 2, length)) -
+                          g_utf8_offset_to_pointer (expected->str, position));
+        }
+
+      g_assert_cmpstr (gtk_entry_buffer_get_text (buffer), ==, expected->str);
+      g_assert_cmpuint (gtk_entry_buffer_get_length (buffer), ==, g_utf8_strlen (expected->str, -1));
+    }
+
+  g_string_free (expected, TRUE);
+  g_object_unref (buffer);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -351,6 +396,7 @@ main (int   argc,
   g_test_add_func ("/entry/delete", test_delete);
   g_test_add_func ("/entry/insert", test_insert);
   g_test_add_func ("/entry/editable", test_editable);
+  g_test_add_func ("/entry/buffer-offsets", test_buffer_offsets);
 
   return g_test_run();
 }
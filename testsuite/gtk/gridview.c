@@ -0,0 +1,263 @@
+#include <math.h>
+#include <stdlib.h>
+
+#include <gtk/gtk.h>
+#include "gtk/gtklistbaseprivate.h"
+
+#define N_ITEMS 1000
+#define N_COLUMNS 2
+
+/* A row far away from the start, it is only estimated once the grid
+ * scrolls close to it */
+#define FAR_ROW 400
+
+static guint n_estimates;
+
+static int
+item_height (guint item,
+             int   column_width)
+{
+  return column_width * (1 + item % 5) / 4;
+}
+
+static int
+item_size_func (gpointer item,
+                int      column_width,
+                gpointer user_data)
+{
+  const char *string = gtk_string_object_get_string (item);
+
+  n_estimates++;
+  g_object_set_data (item, "estimate-width", GINT_TO_POINTER (column_width));
+
+  return item_height (atoi (string), column_width);
+}
+
+static GtkStringList *
+create_model (void)
+{
+  GtkStringList *list;
+  guint i;
+
+  list = gtk_string_list_new (NULL);
+  for (i = 0; i < N_ITEMS; i++)
+    {
+      char *s = g_strdup_printf ("%u", i);
+      gtk_string_list_append (list, s);
+      g_free (s);
+    }
+
+  return list;
+}
+
+static void
+clear_estimates (GtkStringList *list)
+{
+  guint i;
+
+  for (i = 0; i < g_list_model_get_n_items (G_LIST_MODEL (list)); i++)
+    {
+      GObject *item = g_list_model_get_item (G_LIST_MODEL (list), i);
+
+      g_object_set_data (item, "estimate-width", NULL);
+      g_object_unref (item);
+    }
+}
+
+static GtkWidget *
+create_grid (GtkStringList *list)
+{
+  GtkWidget *grid;
+
+  grid = gtk_grid_view_new (GTK_SELECTION_MODEL (gtk_no_selection_new (g_object_ref (G_LIST_MODEL (list)))), NULL);
+  gtk_grid_view_set_min_columns (GTK_GRID_VIEW (grid), N_COLUMNS);
+  gtk_grid_view_set_max_columns (GTK_GRID_VIEW (grid), N_COLUMNS);
+  gtk_grid_view_set_item_size_func (GTK_GRID_VIEW (grid), item_size_func, NULL, NULL);
+  g_object_ref_sink (grid);
+
+  return grid;
+}
+
+static void
+allocate_grid (GtkWidget *grid,
+               int        width,
+               int        height)
+{
+  gtk_widget_measure (grid, GTK_ORIENTATION_HORIZONTAL, -1, NULL, NULL, NULL, NULL);
+  gtk_widget_measure (grid, GTK_ORIENTATION_VERTICAL, width, NULL, NULL, NULL, NULL);
+  gtk_widget_allocate (grid, width, height, -1, NULL);
+}
+
+/* The estimated height of a row, scaled to @column_width,
+ * or 0 if not all of its items have been estimated */
+static int
+estimated_row_height (GtkStringList *list,
+                      guint          row,
+                      int            column_width)
+{
+  int height = 0;
+  int estimate_width = 0;
+  guint i;
+
+  for (i = row * N_COLUMNS; i < (row + 1) * N_COLUMNS; i++)
+    {
+      GObject *item = g_list_model_get_item (G_LIST_MODEL (list), i);
+
+      estimate_width = GPOINTER_TO_INT (g_object_get_data (item, "estimate-width"));
+      g_object_unref (item);
+      if (estimate_width == 0)
+        return 0;
+
+      height = MAX (height, item_height (atoi (gtk_string_list_get_string (list, i)), estimate_width));
+    }
+
+  return MAX (round (height * ((double) column_width / estimate_width)), 1);
+}
+
+static gboolean
+row_has_widgets (GtkListItemManager *manager,
+                 guint               row)
+{
+  guint i;
+
+  for (i = row * N_COLUMNS; i < (row + 1) * N_COLUMNS; i++)
+    {
+      if (gtk_list_item_manager_get_nth (manager, i, NULL)->widget)
+        return TRUE;
+    }
+
+  return FALSE;
+}
+
+/* Checks the rows without widgets and returns how many of them
+ * were estimated */
+static guint
+check_rows (GtkWidget     *grid,
+            GtkStringList *list)
+{
+  GtkListBase *base = GTK_LIST_BASE (grid);
+  GtkListBaseClass *class = GTK_LIST_BASE_GET_CLASS (base);
+  GtkListItemManager *manager = gtk_list_base_get_manager (base);
+  GdkRectangle area, next, found;
+  int xspacing, yspacing, column_width, estimated, unknown_height;
+  guint row, n_rows, pos, col, n_estimated;
+
+  gtk_list_base_get_border_spacing (base, &xspacing, &yspacing);
+  n_rows = g_list_model_get_n_items (G_LIST_MODEL (list)) / N_COLUMNS;
+  unknown_height = -1;
+  n_estimated = 0;
+
+  for (row = 0; row + 1 < n_rows; row++)
+    {
+      if (row_has_widgets (manager, row))
+        continue;
+
+      pos = row * N_COLUMNS;
+      g_assert_true (class->get_allocation (base, pos, &area));
+      g_assert_true (class->get_allocation (base, pos + N_COLUMNS, &next));
+      column_width = area.width;
+      g_assert_cmpint (next.y - area.y, ==, area.height + yspacing);
+
+      /* Estimated rows are as high as their largest estimate,
+       * all others get the same height */
+      estimated = estimated_row_height (list, row, column_width);
+      if (estimated > 0)
+        {
+          g_assert_cmpint (area.height, ==, estimated);
+          n_estimated++;
+        }
+      else
+        {
+          if (unknown_height < 0)
+            unknown_height = area.height;
+          g_assert_cmpint (area.height, ==, unknown_height);
+        }
+
+      /* Every point of the row maps back to its items */
+      for (col = 0; col < N_COLUMNS; col++)
+        {
+          guint found_pos;
+          int x = col * (column_width + xspacing) + column_width / 2;
+
+          g_assert_true (class->get_position_from_allocation (base, x, area.y, &found_pos, &found));
+          g_assert_cmpuint (found_pos, ==, pos + col);
+          g_assert_cmpint (found.y, ==, area.y);
+          g_assert_cmpint (found.height, ==, area.height);
+
+          g_assert_true (class->get_position_from_allocation (base, x, area.y + area.height - 1, &found_pos, NULL));
+          g_assert_cmpuint (found_pos, ==, pos + col);
+        }
+    }
+
+  return n_estimated;
+}
+
+static void
+test_estimates (void)
+{
+  GtkStringList *list;
+  GtkWidget *grid;
+  int xspacing, yspacing;
+  guint n;
+
+  list = create_model ();
+  grid = create_grid (list);
+  gtk_list_base_get_border_spacing (GTK_LIST_BASE (grid), &xspacing, &yspacing);
+
+  /* Only the rows close to the anchor are estimated */
+  n_estimates = 0;
+  allocate_grid (grid, 400, 300);
+  g_assert_cmpuint (n_estimates, >, 0);
+  g_assert_cmpuint (n_estimates, <, N_ITEMS / 2);
+  g_assert_cmpint (estimated_row_height (list, FAR_ROW, 1), ==, 0);
+  g_assert_cmpuint (check_rows (grid, list), >, 0);
+
+  /* Scrolling estimates the rows that come close */
+  n = n_estimates;
+  gtk_grid_view_scroll_to (GTK_GRID_VIEW (grid), FAR_ROW * N_COLUMNS, GTK_LIST_SCROLL_NONE, NULL);
+  allocate_grid (grid, 400, 300);
+  g_assert_cmpuint (n_estimates, >, n);
+  g_assert_cmpuint (n_estimates, <, N_ITEMS);
+  g_assert_cmpint (estimated_row_height (list, FAR_ROW, 1), >, 0);
+  g_assert_cmpuint (check_rows (grid, list), >, 0);
+
+  /* Changing the width scales the estimates without asking for them again */
+  n = n_estimates;
+  allocate_grid (grid, 300, 300);
+  g_assert_cmpuint (n_estimates, ==, n);
+  g_assert_cmpuint (check_rows (grid, list), >, 0);
+
+  allocate_grid (grid, 523, 300);
+  g_assert_cmpuint (n_estimates, ==, n);
+  g_assert_cmpuint (check_rows (grid, list), >, 0);
+
+  /* Only changed items are estimated again */
+  gtk_string_list_splice (list, FAR_ROW * N_COLUMNS + 3, 2, (const char *[]) { "3", "1", "4", NULL });
+  allocate_grid (grid, 523, 300);
+  g_assert_cmpuint (n_estimates, ==, n + 3);
+  g_assert_cmpuint (check_rows (grid, list), >, 0);
+
+  /* Setting the function again estimates the rows close to the anchor
+   * at the current width */
+  n = n_estimates;
+  clear_estimates (list);
+  gtk_grid_view_set_item_size_func (GTK_GRID_VIEW (grid), item_size_func, NULL, NULL);
+  allocate_grid (grid, 523, 300);
+  g_assert_cmpuint (n_estimates, >, n);
+  g_assert_cmpuint (n_estimates, <, n + N_ITEMS);
+  g_assert_cmpint (estimated_row_height (list, 0, 1), ==, 0);
+  g_assert_cmpuint (check_rows (grid, list), >, 0);
+
+  g_object_unref (grid);
+  g_object_unref (list);
+}
+
+int
+main (int argc, char *argv[])
+{
+  gtk_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/gridview/estimates", test_estimates);
+
+  return g_test_run ();
+}
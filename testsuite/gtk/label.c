@@ -229,6 +229,38 @@ test_label_parse_more (void)
   g_object_unref (label);
 }
 
+static void
+test_label_measure_repeated (void)
+{
+  GtkWidget *label1, *label2;
+  int min1, nat1, min2, nat2;
+
+  label1 = g_object_ref_sink (gtk_label_new ("Hello world"));
+  label2 = g_object_ref_sink (gtk_label_new ("Hello world"));
+
+  /* The second measurement is answered from the size cache */
+  gtk_widget_measure (label1, GTK_ORIENTATION_HORIZONTAL, -1, &min1, &nat1, NULL, NULL);
+  gtk_widget_measure (label2, GTK_ORIENTATION_HORIZONTAL, -1, &min2, &nat2, NULL, NULL);
+  g_assert_cmpint (min1, ==, min2);
+  g_assert_cmpint (nat1, ==, nat2);
+
+  gtk_label_set_text (GTK_LABEL (label2), "Hello world, hello world");
+  gtk_widget_measure (label2, GTK_ORIENTATION_HORIZONTAL, -1, &min2, &nat2, NULL, NULL);
+  g_assert_cmpint (nat2, >, nat1);
+
+  /* Attributes are part of the key */
+  gtk_label_set_markup (GTK_LABEL (label2), "<span size='xx-large'>Hello world</span>");
+  gtk_widget_measure (label2, GTK_ORIENTATION_HORIZONTAL, -1, &min2, &nat2, NULL, NULL);
+  g_assert_cmpint (nat2, >, nat1);
+
+  gtk_label_set_text (GTK_LABEL (label2), "Hello world");
+  gtk_widget_measure (label2, GTK_ORIENTATION_HORIZONTAL, -1, &min2, &nat2, NULL, NULL);
+  g_assert_cmpint (nat2, ==, nat1);
+
+  g_object_unref (label1);
+  g_object_unref (label2);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -237,6 +269,7 @@ main (int argc, char *argv[])
   g_test_add_func ("/label/markup-parse", test_label_markup);
   g_test_add_func ("/label/underline-parse", test_label_underline);
   g_test_add_func ("/label/parse-more", test_label_parse_more);
+  g_test_add_func ("/label/measure-repeated", test_label_measure_repeated);
 
   return g_test_run ();
 }
@@ -378,6 +378,69 @@ test_create_with_items (void)
   gtk_window_destroy (GTK_WINDOW (widget));
 }
 
+static void
+test_recycle_on_model_change (void)
+{
+  GListModel *source;
+  GtkNoSelection *selection;
+  GtkListItemManager *items;
+  GtkListItemTracker *tracker;
+  GtkWidget *widget;
+  guint n_created, n_recycled;
+
+  widget = gtk_window_new ();
+  items = gtk_list_item_manager_new (widget,
+                                     split_simple,
+                                     create_simple_item,
+                                     prepare_simple,
+                                     create_simple_header);
+  g_object_set_data_full (G_OBJECT (widget), "the-items", items, g_object_unref);
+  tracker = gtk_list_item_tracker_new (items);
+
+  source = create_source_model (20, 50);
+  selection = gtk_no_selection_new (source);
+  gtk_list_item_manager_set_model (items, GTK_SELECTION_MODEL (selection));
+  gtk_list_item_tracker_set_position (items, tracker, 5, 2, 2);
+  check_list_item_manager (items, widget, &tracker, 1);
+  gtk_list_item_manager_get_item_stats (items, &n_created, &n_recycled);
+  g_assert_cmpuint (n_created, ==, 5);
+  g_assert_cmpuint (n_recycled, ==, 0);
+  g_object_unref (selection);
+
+  /* a new model reuses the existing widgets */
+  source = create_source_model (20, 50);
+  selection = gtk_no_selection_new (source);
+  gtk_list_item_manager_set_model (items, GTK_SELECTION_MODEL (selection));
+  gtk_list_item_tracker_set_position (items, tracker, 5, 2, 2);
+  check_list_item_manager (items, widget, &tracker, 1);
+  gtk_list_item_manager_get_item_stats (items, &n_created, &n_recycled);
+  g_assert_cmpuint (n_created, ==, 5);
+  g_assert_cmpuint (n_recycled, ==, 5);
+
+  /* widgets are kept around without a model */
+  gtk_list_item_manager_set_model (items, NULL);
+  gtk_list_item_manager_set_model (items, GTK_SELECTION_MODEL (selection));
+  gtk_list_item_tracker_set_position (items, tracker, 5, 2, 2);
+  check_list_item_manager (items, widget, &tracker, 1);
+  gtk_list_item_manager_get_item_stats (items, &n_created, &n_recycled);
+  g_assert_cmpuint (n_created, ==, 5);
+  g_assert_cmpuint (n_recycled, ==, 10);
+
+  /* unless that is disabled */
+  gtk_list_item_manager_set_max_spare_items (items, 0);
+  gtk_list_item_manager_set_model (items, NULL);
+  gtk_list_item_manager_set_model (items, GTK_SELECTION_MODEL (selection));
+  gtk_list_item_tracker_set_position (items, tracker, 5, 2, 2);
+  check_list_item_manager (items, widget, &tracker, 1);
+  gtk_list_item_manager_get_item_stats (items, &n_created, &n_recycled);
+  g_assert_cmpuint (n_created, ==, 10);
+  g_assert_cmpuint (n_recycled, ==, 10);
+
+  gtk_list_item_tracker_free (items, tracker);
+  g_object_unref (selection);
+  gtk_window_destroy (GTK_WINDOW (widget));
+}
+
 #define N_TRACKERS 3
 #define N_WIDGETS_PER_TRACKER 10
 #define N_RUNS 500
@@ -561,6 +624,7 @@ main (int argc, char *argv[])
   g_test_add_func ("/listitemmanager/create", test_create);
   g_test_add_func ("/listitemmanager/create_with_items", test_create_with_items);
   g_test_add_func ("/listitemmanager/exhaustive", test_exhaustive);
+  g_test_add_func ("/listitemmanager/recycle-on-model-change", test_recycle_on_model_change);
 
   return g_test_run ();
 }
@@ -556,6 +556,46 @@ test_readd (void)
   g_object_unref (selection);
 }
 
+static void
+test_readd_bulk (void)
+{
+  GtkSelectionModel *selection;
+  GListStore *store;
+  gboolean ret;
+
+  store = new_store (1, 10, 1);
+
+  selection = new_model (G_LIST_MODEL (store));
+
+  ret = gtk_selection_model_select_all (selection);
+  g_assert_true (ret);
+  assert_selection (selection, "1 2 3 4 5 6 7 8 9 10");
+  assert_selection_changes (selection, "0:10");
+
+  /* large unselection, items get dropped by position */
+  ret = gtk_selection_model_unselect_range (selection, 2, 6);
+  g_assert_true (ret);
+  assert_selection (selection, "1 2 9 10");
+  assert_selection_changes (selection, "2:6");
+
+  g_list_model_items_changed (G_LIST_MODEL (store), 0, 10, 10);
+  assert_changes (selection, "0-10+10");
+  assert_selection (selection, "1 2 9 10");
+
+  /* small unselection, items get looked up */
+  ret = gtk_selection_model_unselect_item (selection, 0);
+  g_assert_true (ret);
+  assert_selection (selection, "2 9 10");
+  assert_selection_changes (selection, "0:1");
+
+  g_list_model_items_changed (G_LIST_MODEL (store), 0, 10, 10);
+  assert_changes (selection, "0-10+10");
+  assert_selection (selection, "2 9 10");
+
+  g_object_unref (store);
+  g_object_unref (selection);
+}
+
 static void
 test_set_selection (void)
 {
@@ -880,6 +920,7 @@ main (int argc, char *argv[])
   g_test_add_func ("/multiselection/selection", test_selection);
   g_test_add_func ("/multiselection/select-range", test_select_range);
   g_test_add_func ("/multiselection/readd", test_readd);
+  g_test_add_func ("/multiselection/readd-bulk", test_readd_bulk);
   g_test_add_func ("/multiselection/set_selection", test_set_selection);
   g_test_add_func ("/multiselection/selection-filter", test_selection_filter);
   g_test_add_func ("/multiselection/set-model", test_set_model);
@@ -0,0 +1,159 @@
+#include <gtk/gtk.h>
+
+/* A widget that fills its allocation with an opaque color and counts
+ * how often it is snapshotted */
+typedef struct
+{
+  GtkWidget parent_instance;
+
+  GdkRGBA color;
+  guint n_snapshots;
+} DrawWidget;
+
+typedef GtkWidgetClass DrawWidgetClass;
+
+static GType draw_widget_get_type (void);
+
+G_DEFINE_TYPE (DrawWidget, draw_widget, GTK_TYPE_WIDGET)
+
+static void
+draw_widget_snapshot (GtkWidget   *widget,
+                      GtkSnapshot *snapshot)
+{
+  DrawWidget *self = (DrawWidget *) widget;
+
+  self->n_snapshots++;
+
+  gtk_snapshot_append_color (snapshot,
+                             &self->color,
+                             &GRAPHENE_RECT_INIT (0, 0,
+                                                  gtk_widget_get_width (widget),
+                                                  gtk_widget_get_height (widget)));
+}
+
+static void
+draw_widget_class_init (DrawWidgetClass *class)
+{
+  class->snapshot = draw_widget_snapshot;
+}
+
+static void
+draw_widget_init (DrawWidget *self)
+{
+}
+
+static DrawWidget *
+draw_widget_new (const char *color)
+{
+  DrawWidget *self = g_object_new (draw_widget_get_type (), NULL);
+
+  gdk_rgba_parse (&self->color, color);
+
+  return self;
+}
+
+static void
+count_frame (GdkFrameClock *clock,
+             guint         *n_frames)
+{
+  (*n_frames)++;
+}
+
+static void
+wait_for_frame (guint *n_frames)
+{
+  gint64 end_time = g_get_monotonic_time () + 5 * G_USEC_PER_SEC;
+  guint n = *n_frames;
+
+  while (*n_frames == n)
+    {
+      g_main_context_iteration (NULL, TRUE);
+      g_assert_cmpint (g_get_monotonic_time (), <, end_time);
+    }
+}
+
+static void
+redraw (GtkWidget *widget,
+        guint     *n_frames)
+{
+  gtk_widget_queue_draw (widget);
+  wait_for_frame (n_frames);
+}
+
+static void
+test_overlay (gconstpointer data)
+{
+  gboolean clip = GPOINTER_TO_UINT (data);
+  GtkWidget *window, *overlay;
+  DrawWidget *main_child, *cover;
+  gint64 end_time;
+  guint n_frames = 0;
+  guint n;
+
+  window = gtk_window_new ();
+  gtk_window_set_default_size (GTK_WINDOW (window), 200, 200);
+  overlay = gtk_overlay_new ();
+  if (clip)
+    gtk_widget_set_overflow (overlay, GTK_OVERFLOW_HIDDEN);
+  main_child = draw_widget_new ("red");
+  gtk_overlay_set_child (GTK_OVERLAY (overlay), GTK_WIDGET (main_child));
+  cover = draw_widget_new ("blue");
+  gtk_overlay_add_overlay (GTK_OVERLAY (overlay), GTK_WIDGET (cover));
+  gtk_window_set_child (GTK_WINDOW (window), overlay);
+
+  gtk_window_present (GTK_WINDOW (window));
+  g_signal_connect (gtk_widget_get_frame_clock (window), "after-paint",
+                    G_CALLBACK (count_frame), &n_frames);
+
+  end_time = g_get_monotonic_time () + 5 * G_USEC_PER_SEC;
+  while (main_child->n_snapshots == 0 || cover->n_snapshots == 0)
+    {
+      g_main_context_iteration (NULL, TRUE);
+      g_assert_cmpint (g_get_monotonic_time (), <, end_time);
+    }
+
+  /* Make sure the cover has an up-to-date render node */
+  redraw (GTK_WIDGET (cover), &n_frames);
+
+  /* A child below an opaque sibling is not snapshotted */
+  n = main_child->n_snapshots;
+  redraw (GTK_WIDGET (main_child), &n_frames);
+  g_assert_cmpuint (main_child->n_snapshots, ==, n);
+
+  /* It is drawn once the cover needs to be redrawn itself */
+  redraw (GTK_WIDGET (cover), &n_frames);
+  g_assert_cmpuint (main_child->n_snapshots, ==, n + 1);
+
+  n = main_child->n_snapshots;
+  redraw (GTK_WIDGET (main_child), &n_frames);
+  g_assert_cmpuint (main_child->n_snapshots, ==, n);
+
+  /* ... or once the cover goes away */
+  gtk_widget_set_visible (GTK_WIDGET (cover), FALSE);
+  wait_for_frame (&n_frames);
+  g_assert_cmpuint (main_child->n_snapshots, ==, n + 1);
+
+  /* A cover that leaves a line uncovered does not hide anything */
+  gtk_widget_set_margin_bottom (GTK_WIDGET (cover), 1);
+  gtk_widget_set_visible (GTK_WIDGET (cover), TRUE);
+  wait_for_frame (&n_frames);
+  redraw (GTK_WIDGET (cover), &n_frames);
+
+  n = main_child->n_snapshots;
+  redraw (GTK_WIDGET (main_child), &n_frames);
+  g_assert_cmpuint (main_child->n_snapshots, ==, n + 1);
+
+  g_signal_handlers_disconnect_by_func (gtk_widget_get_frame_clock (window), count_frame, &n_frames);
+  gtk_window_destroy (GTK_WINDOW (window));
+}
+
+int
+main (int argc, char *argv[])
+{
+  gtk_test_init (&argc, &argv);
+
+  g_test_add_data_func ("/occlusion/overlay", GUINT_TO_POINTER (FALSE), test_overlay);
+  g_test_add_data_func ("/occlusion/overlay-clipped", GUINT_TO_POINTER (TRUE), test_overlay);
+
+  return g_test_run ();
+}
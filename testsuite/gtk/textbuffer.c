@@ -1921,6 +1921,222 @@ test_serialize_wrap_mode (void)
   g_assert_finalize_object (buffer);
 }
 
+static void
+test_insert_end_iter (void)
+{
+  GtkTextBuffer *buffer = gtk_text_buffer_new (NULL);
+  GtkTextIter iter;
+
+  gtk_text_buffer_set_text (buffer, "ab", -1);
+
+  gtk_text_buffer_get_iter_at_offset (buffer, &iter, 1);
+  gtk_text_buffer_insert (buffer, &iter, "xy", -1);
+  g_assert_cmpint (gtk_text_iter_get_offset (&iter), ==, 3);
+  g_assert_cmpint (gtk_text_iter_get_line (&iter), ==, 0);
+
+  gtk_text_buffer_insert (buffer, &iter, "1\n22\n\u00e4\u00f6", -1);
+  g_assert_cmpint (gtk_text_iter_get_offset (&iter), ==, 10);
+  g_assert_cmpint (gtk_text_iter_get_line (&iter), ==, 2);
+  g_assert_cmpint (gtk_text_iter_get_line_offset (&iter), ==, 2);
+  g_assert_cmpint (gtk_text_iter_get_line_index (&iter), ==, 4);
+  g_assert_cmpint (gtk_text_iter_get_char (&iter), ==, 'b');
+
+  gtk_text_buffer_insert (buffer, &iter, "\r\n", -1);
+  g_assert_cmpint (gtk_text_iter_get_line (&iter), ==, 3);
+  g_assert_cmpint (gtk_text_iter_get_line_offset (&iter), ==, 0);
+  g_assert_cmpint (gtk_text_iter_get_char (&iter), ==, 'b');
+
+  check_buffer_contents (buffer, "axy1\n22\n\u00e4\u00f6\r\nb");
+
+  g_object_unref (buffer);
+}
+
+static void
+test_new_from_bytes (void)
+{
+  GtkTextBuffer *buffer;
+  GBytes *bytes;
+
+  bytes = g_bytes_new_static ("line 1\nline 2\nline 3", strlen ("line 1\nline 2\nline 3"));
+  buffer = gtk_text_buffer_new_from_bytes (NULL, bytes);
+  g_bytes_unref (bytes);
+
+  g_assert_nonnull (buffer);
+  check_buffer_contents (buffer, "line 1\nline 2\nline 3");
+  g_assert_cmpint (gtk_text_buffer_get_line_count (buffer), ==, 3);
+  g_assert_cmpint (gtk_text_buffer_get_char_count (buffer), ==, 20);
+  g_assert_false (gtk_text_buffer_get_can_undo (buffer));
+  g_assert_finalize_object (buffer);
+
+  bytes = g_bytes_new_static ("", 0);
+  buffer = gtk_text_buffer_new_from_bytes (NULL, bytes);
+  g_bytes_unref (bytes);
+  check_buffer_contents (buffer, "");
+  g_assert_finalize_object (buffer);
+
+  bytes = g_bytes_new_static ("in\xffvalid", 7);
+  buffer = gtk_text_buffer_new_from_bytes (NULL, bytes);
+  g_bytes_unref (bytes);
+  g_assert_null (buffer);
+}
+
+static void
+test_max_lines (void)
+{
+  GtkTextBuffer *buffer = gtk_text_buffer_new (NULL);
+  GtkTextIter iter, start;
+  GtkTextTag *tag;
+  GSList *tags;
+  char *text;
+  int i;
+
+  gtk_text_buffer_set_text (buffer, "1\n2\n3\n4\n5", -1);
+  gtk_text_buffer_set_max_lines (buffer, 3);
+  g_assert_cmpint (gtk_text_buffer_get_max_lines (buffer), ==, 3);
+  check_buffer_contents (buffer, "3\n4\n5");
+
+  gtk_text_buffer_get_end_iter (buffer, &iter);
+  gtk_text_buffer_insert (buffer, &iter, "\n6\n7", -1);
+  check_buffer_contents (buffer, "5\n6\n7");
+  g_assert_true (gtk_text_iter_is_end (&iter));
+  g_assert_false (gtk_text_buffer_get_can_undo (buffer));
+
+  /* lines get dropped across many btree nodes at once */
+  gtk_text_buffer_set_max_lines (buffer, 0);
+  for (i = 8; i < 1000; i++)
+    {
+      text = g_strdup_printf ("\n%d", i);
+      gtk_text_buffer_insert (buffer, &iter, text, -1);
+      g_free (text);
+    }
+  g_assert_cmpint (gtk_text_buffer_get_line_count (buffer), ==, 995);
+
+  gtk_text_buffer_set_max_lines (buffer, 2);
+  check_buffer_contents (buffer, "998\n999");
+
+  gtk_text_buffer_get_end_iter (buffer, &iter);
+  gtk_text_buffer_insert (buffer, &iter, "\n1000", -1);
+  check_buffer_contents (buffer, "999\n1000");
+  g_assert_true (gtk_text_iter_is_end (&iter));
+
+  /* tags still end up on the inserted text */
+  tag = gtk_text_buffer_create_tag (buffer, "bold", "weight", PANGO_WEIGHT_BOLD, NULL);
+  gtk_text_buffer_insert_with_tags (buffer, &iter, "\nab", -1, tag, NULL);
+  check_buffer_contents (buffer, "1000\nab");
+  gtk_text_buffer_get_iter_at_offset (buffer, &start, 4);
+  g_assert_true (gtk_text_iter_starts_tag (&start, tag));
+  gtk_text_buffer_get_start_iter (buffer, &start);
+  g_assert_false (gtk_text_iter_has_tag (&start, tag));
+
+  gtk_text_buffer_insert_markup (buffer, &iter, "\n<b>c</b>d", -1);
+  check_buffer_contents (buffer, "ab\ncd");
+  gtk_text_buffer_get_iter_at_offset (buffer, &start, 3);
+  g_assert_cmpint (gtk_text_iter_get_char (&start), ==, 'c');
+  tags = gtk_text_iter_get_tags (&start);
+  g_assert_cmpint (g_slist_length (tags), ==, 1);
+  g_slist_free (tags);
+  gtk_text_iter_forward_char (&start);
+  tags = gtk_text_iter_get_tags (&start);
+  g_assert_null (tags);
+
+  g_assert_finalize_object (buffer);
+}
+
+static void
+test_max_lines_user_action (void)
+{
+  GtkTextBuffer *buffer = gtk_text_buffer_new (NULL);
+  GtkTextIter iter;
+
+  /* warnings are fatal, so the history must not complain */
+  gtk_text_buffer_set_enable_undo (buffer, TRUE);
+  gtk_text_buffer_set_max_lines (buffer, 3);
+
+  gtk_text_buffer_begin_user_action (buffer);
+  gtk_text_buffer_get_end_iter (buffer, &iter);
+  gtk_text_buffer_insert_interactive (buffer, &iter, "1\n2\n3", -1, TRUE);
+  gtk_text_buffer_insert_interactive (buffer, &iter, "\n4\n5", -1, TRUE);
+  /* lines are only dropped when the user action ends */
+  check_buffer_contents (buffer, "1\n2\n3\n4\n5");
+  gtk_text_buffer_end_user_action (buffer);
+  check_buffer_contents (buffer, "3\n4\n5");
+
+  /* undo does not bring the dropped lines back */
+  gtk_text_buffer_undo (buffer);
+  check_buffer_contents (buffer, "3\n4\n5");
+
+  /* an insertion that does not need a trim can still be undone */
+  gtk_text_buffer_set_max_lines (buffer, 10);
+  gtk_text_buffer_begin_user_action (buffer);
+  gtk_text_buffer_get_end_iter (buffer, &iter);
+  gtk_text_buffer_insert_interactive (buffer, &iter, "\n6", -1, TRUE);
+  gtk_text_buffer_end_user_action (buffer);
+  check_buffer_contents (buffer, "3\n4\n5\n6");
+  g_assert_true (gtk_text_buffer_get_can_undo (buffer));
+  gtk_text_buffer_undo (buffer);
+  check_buffer_contents (buffer, "3\n4\n5");
+
+  g_assert_finalize_object (buffer);
+}
+
+static void
+check_tag_ranges (GtkTextBuffer *buffer,
+                  GtkTextTag    *tag,
+                  const char    *expected)
+{
+  GtkTextIter iter;
+  GString *str;
+
+  str = g_string_new (NULL);
+  gtk_text_buffer_get_start_iter (buffer, &iter);
+  do
+    g_string_append_c (str, gtk_text_iter_has_tag (&iter, tag) ? 'x' : '.');
+  while (gtk_text_iter_forward_char (&iter));
+
+  g_assert_cmpstr (str->str, ==, expected);
+  g_string_free (str, TRUE);
+}
+
+static void
+apply_tag_cb (GtkTextBuffer *buffer,
+              GtkTextTag    *tag,
+              GtkTextIter   *start,
+              GtkTextIter   *end,
+              int           *count)
+{
+  (*count)++;
+}
+
+static void
+test_apply_tag_ranges (void)
+{
+  const int starts[] = { 0, 4, 9, 7, 12, -1 };
+  const int ends[] = { 2, 6, 8, 8, 13, 14 };
+  GtkTextBuffer *buffer;
+  GtkTextTag *tag;
+  int count = 0;
+
+  buffer = gtk_text_buffer_new (NULL);
+  gtk_text_buffer_set_text (buffer, "0123456789\nabcd", -1);
+  tag = gtk_text_buffer_create_tag (buffer, NULL, "weight", PANGO_WEIGHT_BOLD, NULL);
+
+  /* ranges may be unordered, reversed, adjacent or reach the end */
+  gtk_text_buffer_apply_tag_ranges (buffer, tag, starts, ends, G_N_ELEMENTS (starts));
+  check_tag_ranges (buffer, tag, "xx..xx.xx...x.x");
+  g_assert_finalize_object (buffer);
+
+  /* with handlers, the signal is emitted for every range */
+  buffer = gtk_text_buffer_new (NULL);
+  gtk_text_buffer_set_text (buffer, "0123456789\nabcd", -1);
+  tag = gtk_text_buffer_create_tag (buffer, NULL, "weight", PANGO_WEIGHT_BOLD, NULL);
+  g_signal_connect (buffer, "apply-tag", G_CALLBACK (apply_tag_cb), &count);
+
+  gtk_text_buffer_apply_tag_ranges (buffer, tag, starts, ends, G_N_ELEMENTS (starts));
+  check_tag_ranges (buffer, tag, "xx..xx.xx...x.x");
+  g_assert_cmpint (count, ==, G_N_ELEMENTS (starts));
+  g_assert_finalize_object (buffer);
+}
+
 int
 main (int argc, char** argv)
 {
@@ -1949,6 +2165,11 @@ main (int argc, char** argv)
   g_test_add_func ("/TextBuffer/Undo 4", test_undo4);
   g_test_add_func ("/TextBuffer/Undo 5", test_undo5);
   g_test_add_func ("/TextBuffer/Serialize wrap-mode", test_serialize_wrap_mode);
+  g_test_add_func ("/TextBuffer/Insert end iter", test_insert_end_iter);
+  g_test_add_func ("/TextBuffer/New from bytes", test_new_from_bytes);
+  g_test_add_func ("/TextBuffer/Max lines", test_max_lines);
+  g_test_add_func ("/TextBuffer/Max lines in user action", test_max_lines_user_action);
+  g_test_add_func ("/TextBuffer/Apply tag ranges", test_apply_tag_ranges);
 
   return g_test_run();
 }
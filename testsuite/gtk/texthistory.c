@@ -44,6 +44,7 @@ enum {
   SELECT,
   CHECK_SELECT,
   SET_MAX_UNDO,
+  SET_MAX_BYTES,
 };
 
 typedef struct
@@ -310,6 +311,10 @@ run_test (const Command *commands,
           gtk_text_history_set_max_undo_levels (text->history, cmd->location);
           break;
 
+        case SET_MAX_BYTES:
+          gtk_text_history_set_max_bytes (text->history, cmd->location);
+          break;
+
         default:
           break;
         }
@@ -602,6 +607,47 @@ test14 (void)
   g_free (fill_after_2);
 }
 
+static void
+test_max_bytes (void)
+{
+  static const Command commands[] = {
+    { SET_MAX_BYTES, 10, -1, NULL, NULL, UNSET, UNSET, UNSET },
+    { INSERT, 0, -1, "aaaa\n", "aaaa\n", SET, UNSET, UNSET },
+    { INSERT, 5, -1, "bbbb\n", "aaaa\nbbbb\n", SET, UNSET, UNSET },
+    { INSERT, 10, -1, "cccc\n", "aaaa\nbbbb\ncccc\n", SET, UNSET, UNSET },
+    { UNDO, -1, -1, NULL, "aaaa\nbbbb\n", SET, SET, UNSET },
+    { UNDO, -1, -1, NULL, "aaaa\n", UNSET, SET, UNSET },
+    { REDO, -1, -1, NULL, "aaaa\nbbbb\n", SET, SET, UNSET },
+    { SET_MAX_BYTES, 4, -1, NULL, "aaaa\nbbbb\n", SET, UNSET, UNSET },
+    { UNDO, -1, -1, NULL, "aaaa\n", UNSET, SET, UNSET },
+  };
+
+  run_test (commands, G_N_ELEMENTS (commands), 0);
+}
+
+static void
+test_cancel_insert (void)
+{
+  /* The backspace cancels part of the insertion, so the group only
+   * accounts for "abd" and the first insertion fits in the budget.
+   */
+  static const Command commands[] = {
+    { SET_MAX_BYTES, 5, -1, NULL, NULL, UNSET, UNSET, UNSET },
+    { INSERT, 0, -1, "x\n", "x\n", SET, UNSET, UNSET },
+    { BEGIN_USER, -1, -1, NULL, NULL, UNSET, UNSET, UNSET },
+    { INSERT_SEQ, 2, -1, "abc", "x\nabc", UNSET, UNSET, UNSET },
+    { BACKSPACE, 4, 5, "c", "x\nab", UNSET, UNSET, UNSET },
+    { INSERT, 4, -1, "d", "x\nabd", UNSET, UNSET, UNSET },
+    { END_USER, -1, -1, NULL, NULL, SET, UNSET, UNSET },
+    { UNDO, -1, -1, NULL, "x\n", SET, SET, UNSET },
+    { UNDO, -1, -1, NULL, "", UNSET, SET, UNSET },
+    { REDO, -1, -1, NULL, "x\n", SET, SET, UNSET },
+    { REDO, -1, -1, NULL, "x\nabd", SET, UNSET, UNSET },
+  };
+
+  run_test (commands, G_N_ELEMENTS (commands), 0);
+}
+
 static void
 test_issue_4276 (void)
 {
@@ -684,6 +730,8 @@ main (int   argc,
   g_test_add_func ("/Gtk/TextHistory/test12", test12);
   g_test_add_func ("/Gtk/TextHistory/test13", test13);
   g_test_add_func ("/Gtk/TextHistory/test14", test14);
+  g_test_add_func ("/Gtk/TextHistory/max_bytes", test_max_bytes);
+  g_test_add_func ("/Gtk/TextHistory/cancel_insert", test_cancel_insert);
   g_test_add_func ("/Gtk/TextHistory/issue_4276", test_issue_4276);
   g_test_add_func ("/Gtk/TextHistory/issue_4575", test_issue_4575);
   g_test_add_func ("/Gtk/TextHistory/issue_5777", test_issue_5777);
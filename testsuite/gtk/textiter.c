@@ -194,6 +194,57 @@ test_search (void)
   check_found_backward ("aa \303\200", "aa", 0, 0, 2, "aa");
 }
 
+static void
+test_search_many_lines (void)
+{
+  GtkTextBuffer *buffer;
+  GtkTextIter iter, start, end, limit;
+  GString *text;
+  int n_found;
+  int i;
+
+  text = g_string_new (NULL);
+  for (i = 0; i < 10000; i++)
+    {
+      if (i % 1000 == 999)
+        g_string_append_printf (text, "line %d has a Needle\n", i);
+      else
+        g_string_append_printf (text, "line %d\n", i);
+    }
+
+  buffer = gtk_text_buffer_new (NULL);
+  gtk_text_buffer_set_text (buffer, text->str, text->len);
+  g_string_free (text, TRUE);
+
+  gtk_text_buffer_get_start_iter (buffer, &iter);
+  g_assert_true (gtk_text_iter_forward_search (&iter, "Needle", 0, &start, &end, NULL));
+  g_assert_cmpint (gtk_text_iter_get_line (&start), ==, 999);
+  g_assert_cmpint (gtk_text_iter_get_line_offset (&start), ==, 15);
+  g_assert_cmpint (gtk_text_iter_get_line_offset (&end), ==, 21);
+
+  g_assert_false (gtk_text_iter_forward_search (&iter, "needle", 0, &start, &end, NULL));
+
+  /* find all matches, ending at the limit */
+  gtk_text_buffer_get_iter_at_line_offset (buffer, &limit, 8999, 21);
+  n_found = 0;
+  while (gtk_text_iter_forward_search (&iter, "needle",
+                                       GTK_TEXT_SEARCH_CASE_INSENSITIVE,
+                                       &start, &end, &limit))
+    {
+      g_assert_cmpint (gtk_text_iter_get_line (&start), ==, n_found * 1000 + 999);
+      n_found++;
+      iter = end;
+    }
+  g_assert_cmpint (n_found, ==, 9);
+
+  /* a match crossing the limit is not found */
+  gtk_text_buffer_get_start_iter (buffer, &iter);
+  gtk_text_buffer_get_iter_at_line_offset (buffer, &limit, 999, 20);
+  g_assert_false (gtk_text_iter_forward_search (&iter, "Needle", 0, &start, &end, &limit));
+
+  g_object_unref (buffer);
+}
+
 static void
 test_search_caseless (void)
 {
@@ -841,6 +892,7 @@ main (int argc, char** argv)
   g_test_add_func ("/TextIter/Search Full Buffer", test_search_full_buffer);
   g_test_add_func ("/TextIter/Search", test_search);
   g_test_add_func ("/TextIter/Search Caseless", test_search_caseless);
+  g_test_add_func ("/TextIter/Search Many Lines", test_search_many_lines);
   g_test_add_func ("/TextIter/Forward To Tag Toggle", test_forward_to_tag_toggle);
   g_test_add_func ("/TextIter/Forward To Line End", test_forward_to_line_end);
   g_test_add_func ("/TextIter/Word Boundaries", test_word_boundaries);
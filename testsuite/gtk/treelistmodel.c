@@ -613,6 +613,227 @@ test_same_child_model (void)
     g_object_unref (models[i]);
 }
 
+static GListModel *
+counting_create_model_cb (gpointer item,
+                          gpointer data)
+{
+  guint *n_created = data;
+
+  (*n_created)++;
+
+  return create_sub_model_cb (item, NULL);
+}
+
+static void
+test_prefetch (void)
+{
+  GtkTreeListModel *tree;
+  GtkTreeListRow *row;
+  guint n_created = 0;
+  guint i;
+
+  tree = gtk_tree_list_model_new (G_LIST_MODEL (new_store (100, 100, 100)),
+                                  FALSE, FALSE,
+                                  counting_create_model_cb, &n_created, NULL);
+  g_assert_cmpuint (n_created, ==, 0);
+
+  /* the root row is the only one */
+  gtk_tree_list_model_prefetch (tree, 0, 100);
+  g_assert_cmpuint (n_created, ==, 1);
+  g_assert_cmpuint (g_list_model_get_n_items (G_LIST_MODEL (tree)), ==, 1);
+
+  /* expanding reuses the prefetched model */
+  row = gtk_tree_list_model_get_row (tree, 0);
+  g_assert_true (gtk_tree_list_row_is_expandable (row));
+  gtk_tree_list_row_set_expanded (row, TRUE);
+  g_assert_cmpuint (n_created, ==, 1);
+  g_assert_cmpuint (g_list_model_get_n_items (G_LIST_MODEL (tree)), ==, 11);
+
+  /* prefetching twice does nothing */
+  gtk_tree_list_model_prefetch (tree, 1, 10);
+  g_assert_cmpuint (n_created, ==, 11);
+  gtk_tree_list_model_prefetch (tree, 1, 10);
+  g_assert_cmpuint (n_created, ==, 11);
+
+  for (i = 10; i > 0; i--)
+    {
+      GtkTreeListRow *child = gtk_tree_list_model_get_row (tree, i);
+      gtk_tree_list_row_set_expanded (child, TRUE);
+      g_object_unref (child);
+    }
+  g_assert_cmpuint (n_created, ==, 11);
+  g_assert_cmpuint (g_list_model_get_n_items (G_LIST_MODEL (tree)), ==, 111);
+
+  /* collapsing drops the children, so they need to be recreated */
+  gtk_tree_list_row_set_expanded (row, FALSE);
+  gtk_tree_list_row_set_expanded (row, TRUE);
+  gtk_tree_list_model_prefetch (tree, 0, 11);
+  g_assert_cmpuint (n_created, ==, 22);
+
+  g_object_unref (row);
+  g_object_unref (tree);
+}
+
+/* A synthetic tree with 10 children per node and 7 levels, so it has
+ * more than 10 million nodes. Child models are only created on demand,
+ * so the test only ever materializes a tiny part of it.
+ */
+#define SYNTHETIC_WIDTH 10
+#define SYNTHETIC_DEPTH 7
+
+typedef struct {
+  guint n_created;
+  guint n_alive;
+} SyntheticTree;
+
+static void
+synthetic_model_finalized (gpointer  data,
+                           GObject  *where_the_object_was)
+{
+  SyntheticTree *tree = data;
+
+  tree->n_alive--;
+}
+
+static GListStore *
+synthetic_store_new (guint depth)
+{
+  GListStore *store;
+  guint i;
+
+  store = g_list_store_new (G_TYPE_OBJECT);
+  for (i = 0; i < SYNTHETIC_WIDTH; i++)
+    {
+      GObject *object = g_object_new (G_TYPE_OBJECT, NULL);
+      g_object_set_qdata (object, number_quark, GUINT_TO_POINTER (depth));
+      g_list_store_append (store, object);
+      g_object_unref (object);
+    }
+
+  return store;
+}
+
+static GListModel *
+synthetic_create_model_cb (gpointer item,
+                           gpointer data)
+{
+  SyntheticTree *tree = data;
+  guint depth;
+  GListStore *store;
+
+  depth = GPOINTER_TO_UINT (g_object_get_qdata (item, number_quark));
+  if (depth >= SYNTHETIC_DEPTH)
+    return NULL;
+
+  store = synthetic_store_new (depth + 1);
+  tree->n_created++;
+  tree->n_alive++;
+  g_object_weak_ref (G_OBJECT (store), synthetic_model_finalized, tree);
+
+  return G_LIST_MODEL (store);
+}
+
+static void
+set_expanded (GtkTreeListModel *model,
+              guint             position,
+              gboolean          expanded)
+{
+  GtkTreeListRow *row = gtk_tree_list_model_get_row (model, position);
+
+  gtk_tree_list_row_set_expanded (row, expanded);
+  g_object_unref (row);
+}
+
+static void
+test_prefetch_large (void)
+{
+  SyntheticTree synthetic = { 0, };
+  GtkTreeListModel *tree;
+  guint i, j, n_items;
+
+  tree = gtk_tree_list_model_new (G_LIST_MODEL (synthetic_store_new (1)),
+                                  FALSE, FALSE,
+                                  synthetic_create_model_cb, &synthetic, NULL);
+
+  /* walk down to a leaf along the first child */
+  for (i = 0; i < SYNTHETIC_DEPTH - 1; i++)
+    set_expanded (tree, i, TRUE);
+  n_items = g_list_model_get_n_items (G_LIST_MODEL (tree));
+  g_assert_cmpuint (n_items, ==, SYNTHETIC_DEPTH * SYNTHETIC_WIDTH);
+  g_assert_cmpuint (synthetic.n_created, ==, SYNTHETIC_DEPTH - 1);
+
+  /* leaves don't get a model */
+  gtk_tree_list_model_prefetch (tree, 0, n_items);
+  g_assert_cmpuint (synthetic.n_created, ==, n_items - SYNTHETIC_WIDTH);
+  g_assert_cmpuint (synthetic.n_alive, ==, n_items - SYNTHETIC_WIDTH);
+
+  /* collapsing the path releases everything below it */
+  set_expanded (tree, 0, FALSE);
+  g_assert_cmpuint (g_list_model_get_n_items (G_LIST_MODEL (tree)), ==, SYNTHETIC_WIDTH);
+  g_assert_cmpuint (synthetic.n_alive, ==, SYNTHETIC_WIDTH - 1);
+
+  /* expand the first two levels: 10 + 100 + 1000 rows */
+  for (i = SYNTHETIC_WIDTH; i > 0; i--)
+    {
+      set_expanded (tree, i - 1, TRUE);
+      for (j = SYNTHETIC_WIDTH; j > 0; j--)
+        set_expanded (tree, i + j - 1, TRUE);
+    }
+  n_items = g_list_model_get_n_items (G_LIST_MODEL (tree));
+  g_assert_cmpuint (n_items, ==, 1110);
+  g_assert_cmpuint (synthetic.n_alive, ==, 110);
+
+  /* prefetching is capped, the oldest models get dropped */
+  synthetic.n_created = 0;
+  for (i = 0; i < n_items; i += 100)
+    gtk_tree_list_model_prefetch (tree, i, 100);
+  g_assert_cmpuint (synthetic.n_created, ==, 1000);
+  g_assert_cmpuint (synthetic.n_alive, ==, 110 + 256);
+
+  /* the most recently prefetched rows still have their model */
+  synthetic.n_created = 0;
+  set_expanded (tree, n_items - 1, TRUE);
+  g_assert_cmpuint (synthetic.n_created, ==, 0);
+  g_assert_cmpuint (synthetic.n_alive, ==, 110 + 256);
+
+  /* collapsing and prefetching again must not leave a second queue
+   * entry that drops the new model early
+   */
+  set_expanded (tree, n_items - 1, FALSE);
+  g_assert_cmpuint (synthetic.n_alive, ==, 110 + 255);
+  gtk_tree_list_model_prefetch (tree, n_items - 1, 1);
+  g_assert_cmpuint (synthetic.n_created, ==, 1);
+  g_assert_cmpuint (synthetic.n_alive, ==, 110 + 256);
+  /* use up the models of the other prefetched rows on the lowest level */
+  for (i = n_items - 1, j = 0; j < 255; i--)
+    {
+      GtkTreeListRow *row = gtk_tree_list_model_get_row (tree, i - 1);
+
+      if (gtk_tree_list_row_get_depth (row) == 2)
+        {
+          gtk_tree_list_row_set_expanded (row, TRUE);
+          gtk_tree_list_row_set_expanded (row, FALSE);
+          j++;
+        }
+      g_object_unref (row);
+    }
+  g_assert_cmpuint (synthetic.n_created, ==, 1);
+  g_assert_cmpuint (synthetic.n_alive, ==, 110 + 1);
+  synthetic.n_created = 0;
+  set_expanded (tree, n_items - 1, TRUE);
+  g_assert_cmpuint (synthetic.n_created, ==, 0);
+  set_expanded (tree, n_items - 1, FALSE);
+
+  /* collapsing releases the prefetched models of the removed rows */
+  for (i = 0; i < SYNTHETIC_WIDTH; i++)
+    set_expanded (tree, i, FALSE);
+  g_assert_cmpuint (g_list_model_get_n_items (G_LIST_MODEL (tree)), ==, SYNTHETIC_WIDTH);
+  g_assert_cmpuint (synthetic.n_alive, ==, 0);
+
+  g_object_unref (tree);
+  g_assert_cmpuint (synthetic.n_alive, ==, 0);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -627,6 +848,8 @@ main (int argc, char *argv[])
   g_test_add_func ("/treelistmodel/remove_splice", test_splice);
   g_test_add_func ("/treelistmodel/collapse-change", test_collapse_change);
   g_test_add_func ("/treelistmodel/same-child-model", test_same_child_model);
+  g_test_add_func ("/treelistmodel/prefetch", test_prefetch);
+  g_test_add_func ("/treelistmodel/prefetch-large", test_prefetch_large);
 
   return g_test_run ();
 }
@@ -0,0 +1,120 @@
+#include <gtk/gtk.h>
+#include "gtk/gtkwidgetprofilerprivate.h"
+#include "gdk/gdkframeclockidleprivate.h"
+
+static GtkWidget *
+create_box (void)
+{
+  GtkWidget *box;
+  int i;
+
+  box = gtk_box_new (GTK_ORIENTATION_VERTICAL, 0);
+  for (i = 0; i < 3; i++)
+    gtk_box_append (GTK_BOX (box), gtk_label_new ("Hello"));
+
+  return g_object_ref_sink (box);
+}
+
+static const GtkWidgetClassTimings *
+find_timings (const GtkWidgetClassTimings *timings,
+              guint                        n_timings,
+              GType                        type)
+{
+  guint i;
+
+  for (i = 0; i < n_timings; i++)
+    {
+      if (timings[i].type == type)
+        return &timings[i];
+    }
+
+  return NULL;
+}
+
+static void
+layout_box (GtkWidget *box)
+{
+  int min, nat;
+
+  gtk_widget_measure (box, GTK_ORIENTATION_HORIZONTAL, -1, &min, &nat, NULL, NULL);
+  gtk_widget_measure (box, GTK_ORIENTATION_VERTICAL, nat, &min, &nat, NULL, NULL);
+  gtk_widget_allocate (box, 200, 100, -1, NULL);
+}
+
+static void
+test_per_class (void)
+{
+  const GtkWidgetClassTimings *timings, *box_timings, *label_timings;
+  GdkFrameClock *clock;
+  GtkWidget *box;
+  guint i, n;
+
+  box = create_box ();
+  clock = _gdk_frame_clock_idle_new ();
+
+  gtk_widget_profiler_start ();
+  layout_box (box);
+  gtk_widget_profiler_end_frame (clock);
+  gtk_widget_profiler_stop ();
+
+  timings = gtk_widget_profiler_get_last_frame (clock, &n);
+  g_assert_cmpuint (n, ==, 2);
+
+  box_timings = find_timings (timings, n, GTK_TYPE_BOX);
+  label_timings = find_timings (timings, n, GTK_TYPE_LABEL);
+  g_assert_nonnull (box_timings);
+  g_assert_nonnull (label_timings);
+
+  g_assert_cmpuint (box_timings->count[GTK_WIDGET_PHASE_MEASURE], >, 0);
+  g_assert_cmpuint (box_timings->count[GTK_WIDGET_PHASE_ALLOCATE], ==, 1);
+  g_assert_cmpuint (label_timings->count[GTK_WIDGET_PHASE_MEASURE], >=, 3);
+  g_assert_cmpuint (label_timings->count[GTK_WIDGET_PHASE_ALLOCATE], ==, 3);
+
+  /* sorted by total time, most expensive first */
+  for (i = 1; i < n; i++)
+    {
+      gint64 prev = 0, cur = 0;
+      guint j;
+
+      for (j = 0; j < GTK_WIDGET_N_PHASES; j++)
+        {
+          prev += timings[i - 1].time[j];
+          cur += timings[i].time[j];
+        }
+      g_assert_cmpint (prev, >=, cur);
+    }
+
+  g_object_unref (clock);
+  g_object_unref (box);
+}
+
+static void
+test_not_running (void)
+{
+  GdkFrameClock *clock;
+  GtkWidget *box;
+  guint n;
+
+  box = create_box ();
+  clock = _gdk_frame_clock_idle_new ();
+
+  layout_box (box);
+  gtk_widget_profiler_end_frame (clock);
+
+  g_assert_null (gtk_widget_profiler_get_last_frame (clock, &n));
+  g_assert_cmpuint (n, ==, 0);
+
+  g_object_unref (clock);
+  g_object_unref (box);
+}
+
+int
+main (int argc, char *argv[])
+{
+  gtk_test_init (&argc, &argv);
+
+  g_test_add_func ("/widgetprofiler/per-class", test_per_class);
+  g_test_add_func ("/widgetprofiler/not-running", test_not_running);
+
+  return g_test_run ();
+}